@@ -7,6 +7,8 @@
  * \date 6 April 2006
  */
 
+class Random;
+
 /**
  * An instance is a city with x, y, z coordinates.
  */
@@ -14,10 +16,15 @@ class City
 {
 public:
 	/**
-     * City default constructor.
+     * City default constructor. The city is at the origin.
      */
 	City();
 	/**
+     * Overloaded constructor that puts the city at a random position from 0 to 999 on each axis.
+	 * \param rng is the random number generator to draw the position from.
+     */
+	City(Random & rng);
+	/**
      * City copy constructor.
 	 * \param other is the other city to copy.
      */
@@ -1,17 +1,22 @@
 #include <iostream>
 #include <cmath>
-#include <ctime>
 
 #include "City.h"
+#include "Random.h"
 
 using namespace std;
 
 City::City()
+	: x(0), y(0), z(0)
 {
-	//srand(time(NULL));
-	x = rand() % 1000;
-	y = rand() % 1000;
-	z = rand() % 1000;
+
+}
+
+City::City(Random & rng)
+{
+	x = rng.randomInt(1000);
+	y = rng.randomInt(1000);
+	z = rng.randomInt(1000);
 }
 
 City::City(const City & other)
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <cmath>
+
+#include "CityTable.h"
+#include "config.h"
+#include "Random.h"
+
+using namespace std;
+
+CityTable::CityTable()
+{
+
+}
+
+CityTable::CityTable(int num_cities, Random & rng)
+{
+	cities.reserve(num_cities);
+	for(int i = 0; i < num_cities; ++i)
+	{
+		cities.push_back(City(rng));
+	}
+	cacheDistances();
+}
+
+CityTable::~CityTable()
+{
+
+}
+
+int CityTable::addCity(int x, int y, int z)
+{
+	cities.push_back(City(x, y, z));
+
+	// the cached distances no longer cover every city
+	full_matrix.clear();
+	packed_matrix.clear();
+
+	return (int)cities.size() - 1;
+}
+
+int CityTable::getNumCities() const
+{
+	return (int)cities.size();
+}
+
+const City & CityTable::getCity(int index) const
+{
+	return cities[index];
+}
+
+void CityTable::cacheDistances()
+{
+	int num_cities = (int)cities.size();
+
+	full_matrix.clear();
+	packed_matrix.clear();
+
+	if(num_cities <= DISTANCE_MATRIX_LIMIT)
+	{
+		full_matrix.resize((size_t)num_cities * num_cities);
+		for(int i = 0; i < num_cities; ++i)
+		{
+			full_matrix[(size_t)i * num_cities + i] = 0.0;
+			for(int j = 0; j < i; ++j)
+			{
+				double d = calculateDistance(i, j);
+				full_matrix[(size_t)i * num_cities + j] = d;
+				full_matrix[(size_t)j * num_cities + i] = d;
+			}
+		}
+	}
+	else
+	{
+		packed_matrix.resize((size_t)num_cities * (num_cities - 1) / 2);
+		size_t index = 0;
+		for(int i = 1; i < num_cities; ++i)
+		{
+			for(int j = 0; j < i; ++j)
+				packed_matrix[index++] = (float)calculateDistance(i, j);
+		}
+	}
+}
+
+bool CityTable::hasDistanceCache() const
+{
+	return !full_matrix.empty() || !packed_matrix.empty();
+}
+
+double CityTable::calculateDistance(int c1, int c2) const
+{
+	double dx = (double)cities[c2].getX() - (double)cities[c1].getX();
+	double dy = (double)cities[c2].getY() - (double)cities[c1].getY();
+	double dz = (double)cities[c2].getZ() - (double)cities[c1].getZ();
+
+	return sqrt(dx*dx + dy*dy + dz*dz);
+}
@@ -0,0 +1,127 @@
+#ifndef CITYTABLE_H
+#define CITYTABLE_H
+
+/**
+ * \file CityTable.h
+ */
+
+#include "City.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * This class is the instance of a travelling sales person problem. It holds every city
+ * once, in one contiguous block, and is shared read-only by all the genomes that are
+ * touring it. Genomes refer to a city by its index in the table.
+ */
+class CityTable
+{
+public:
+	/**
+	 * Default constructor. Creates an empty table.
+	 */
+	CityTable();
+	/**
+	 * Overloaded constructor that generates num_cities totally randomly positioned cities.
+	 * The distances between them are cached straight away.
+	 * \param num_cities is the number of cities to generate.
+	 * \param rng is the random number generator to draw the positions from.
+	 */
+	CityTable(int num_cities, Random & rng);
+	/**
+	 * Destructor.
+	 */
+	~CityTable();
+
+	/**
+	 * Adds a city to the end of the table.
+	 * \param x is the x position of the city
+	 * \param y is the y position of the city
+	 * \param z is the z position of the city
+	 * \return the index of the new city.
+	 */
+	int addCity(int x, int y, int z);
+
+	/**
+	 * Gets the number of cities in the table.
+	 * \return the number of cities.
+	 */
+	int getNumCities() const;
+	/**
+	 * Gets a city from the table.
+	 * \param index is the index of the city.
+	 * \return a reference to the city.
+	 */
+	const City & getCity(int index) const;
+
+	/**
+	 * Precomputes the distance between every pair of cities. Up to DISTANCE_MATRIX_LIMIT
+	 * cities a full matrix of doubles is kept, above that only the lower triangle is kept
+	 * as floats, which is a quarter of the memory. Adding a city drops the cache.
+	 */
+	void cacheDistances();
+	/**
+	 * Checks if the distances have been precomputed.
+	 * \return true if distance() is a table lookup.
+	 */
+	bool hasDistanceCache() const;
+
+	/**
+	 * Gets the distance between two cities. This is a table lookup once cacheDistances()
+	 * has been called and is calculated from the coordinates otherwise.
+	 * \param c1 is the index of the first city.
+	 * \param c2 is the index of the second city.
+	 * \return the distance between them.
+	 */
+	double distance(int c1, int c2) const;
+	/**
+	 * This function will calculate the distance between two cities from their coordinates.
+	 * \param c1 is the index of the first city.
+	 * \param c2 is the index of the second city.
+	 * \return the distance between them.
+	 */
+	double calculateDistance(int c1, int c2) const;
+
+private:
+	/**
+	 * The table is shared between genomes, so it is not copied.
+	 */
+	CityTable(const CityTable & other);
+	/**
+	 * The table is shared between genomes, so it is not assigned.
+	 */
+	CityTable & operator=(const CityTable & other);
+
+	/**
+	 * The cities of the instance.
+	 */
+	std::vector<City> cities;
+	/**
+	 * The full distance matrix, row major. Empty unless the table is small enough.
+	 */
+	std::vector<double> full_matrix;
+	/**
+	 * The lower triangle of the distance matrix, packed row by row. Used for large tables.
+	 */
+	std::vector<float> packed_matrix;
+};
+
+inline double CityTable::distance(int c1, int c2) const
+{
+	if(!full_matrix.empty())
+		return full_matrix[(std::size_t)c1 * cities.size() + c2];
+
+	if(!packed_matrix.empty())
+	{
+		if(c1 == c2)
+			return 0.0;
+		// row is the larger index, the diagonal is not stored
+		int row = (c1 > c2) ? c1 : c2;
+		int col = (c1 > c2) ? c2 : c1;
+		return packed_matrix[(std::size_t)row * (row - 1) / 2 + col];
+	}
+
+	return calculateDistance(c1, c2);
+}
+
+#endif
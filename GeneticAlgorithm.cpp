@@ -1,23 +1,31 @@
 #include <iostream>
+#include <algorithm>
 
 #include "GeneticAlgorithm.h"
 #include "Statistics.h"
 #include "Population.h"
+#include "Migration.h"
+#include "Reporter.h"
+#include "Observer.h"
+#include "MetricHistory.h"
+#include "Termination.h"
 
 using namespace std;
 
 GeneticAlgorithm::GeneticAlgorithm()
-	: pop(new Population), stats(new Statistics()), current_generation(0)
+	: pop(new Population), stats(new Statistics()), termination(new Termination()), current_generation(0), migration(0), reporter(0), verbose(true), stop_requested(false)
 {
 }
 
 GeneticAlgorithm::GeneticAlgorithm(const GeneticAlgorithm & other)
-	: pop(new Population(*other.pop)), stats(new Statistics()), current_generation(other.current_generation)
+	: pop(new Population(*other.pop)), stats(new Statistics()),
+	  termination(new Termination(*other.termination)), current_generation(other.current_generation),
+	  migration(0), reporter(0), verbose(other.verbose), stop_requested(false)
 {
 }
 
 GeneticAlgorithm::GeneticAlgorithm(Population *in_pop)
-	: pop(in_pop), stats(new Statistics()), current_generation(0)
+	: pop(in_pop), stats(new Statistics()), termination(new Termination()), current_generation(0), migration(0), reporter(0), verbose(true), stop_requested(false)
 {
 }
 
@@ -25,19 +33,14 @@ GeneticAlgorithm::~GeneticAlgorithm()
 {
 	delete pop;
 	delete stats;
+	delete termination;
 }
 
 
 bool GeneticAlgorithm::isFinished()
 {
-	if(TERMINATE_CONDITION == UPON_GENERATION)
-	{
-		return terminateUponGeneration();
-	}
-	else // if(term_cond == UPON_CONVERGENCE)
-	{
-		return terminateUponConvergence();
-	}
+	// TERMINATE_CONDITION picks the rules the termination object starts with, whichever is met first ends the run
+	return terminateUponGeneration() || terminateUponConvergence() || terminateUponBudget();
 }
 
 void GeneticAlgorithm::evolve()
@@ -45,34 +48,147 @@ void GeneticAlgorithm::evolve()
 	init(); // need the scores and best/worst genomes before we init the stats object
 	// we must initialize the stats object
 	stats->init(pop);
+	termination->reset();
+	stop_requested = false;
 
-	while(!isFinished())
+	// the observers are only looked at when there are some, so without them the loop is as it was
+	if(!observers.empty() && stats->getBestGenomeEver())
 	{
-		// init will calculate the scores, fitness, 
-		// and set the best and worst genomes of this population
-		init();
-
-		// write out the current population
-		cout << *this << endl;
+		for(vector<Observer *>::iterator it = observers.begin(); it != observers.end(); ++it)
+			(*it)->onNewBest(*this, *stats->getBestGenomeEver(), current_generation);
+	}
 
-		// stats stats object
-		stats->update(pop);
+	bool new_best = false;
+	for(;;)
+	{
+		// the population was initialized by init() above or at the end of nextGeneration(),
+		// and the stats object has recorded it, so everything below is up to date
+
+		// hand the summary to the reporter's thread, or write out the whole population here
+		if(reporter)
+			reporter->publish(stats->getHistory().last());
+		else if(verbose)
+			cout << *this << endl;
+
+		if(!observers.empty())
+		{
+			const PopulationSummary & summary = pop->getSummary();
+			GenerationMetrics metrics = stats->getHistory().last();
+			for(vector<Observer *>::iterator it = observers.begin(); it != observers.end(); ++it)
+			{
+				if(new_best)
+					(*it)->onNewBest(*this, *stats->getBestGenomeEver(), current_generation);
+				(*it)->onGenerationEnd(*this, summary, metrics);
+			}
+		}
+
+		// the termination rules look at the metrics of the current population
+		if(stop_requested || isFinished())
+			break;
 
 		// generate the next population of genomes.
 		nextGeneration();		
+
+		// let other genetic algorithms exchange genomes with this one
+		if(migration)
+		{
+			migration->migrate(*this);
+			for(vector<Observer *>::iterator it = observers.begin(); it != observers.end(); ++it)
+				(*it)->onMigration(*this);
+		}
+
+		// stats stats object
+		new_best = stats->update(pop);
 	}
+
+	for(vector<Observer *>::iterator it = observers.begin(); it != observers.end(); ++it)
+		(*it)->onTermination(*this, *stats);
+
 	// print out the stats object
-	cout << *stats << endl;
+	if(verbose)
+	{
+		// the reporter must finish first or the two would be mixed up
+		if(reporter)
+			reporter->flush();
+		cout << "Finished after " << current_generation << " generations: "
+			<< (stop_requested ? "stopped by an observer" : termination->getReason()) << endl;
+		cout << *stats << endl;
+	}
+}
+
+void GeneticAlgorithm::addObserver(Observer *observer)
+{
+	observers.push_back(observer);
+}
+
+void GeneticAlgorithm::removeObserver(Observer *observer)
+{
+	observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+}
+
+void GeneticAlgorithm::stop()
+{
+	stop_requested = true;
+}
+
+void GeneticAlgorithm::setMigration(Migration *in_migration)
+{
+	migration = in_migration;
+}
+
+Migration * GeneticAlgorithm::getMigration() const
+{
+	return migration;
+}
+
+void GeneticAlgorithm::setReporter(Reporter *in_reporter)
+{
+	reporter = in_reporter;
+}
+
+Reporter * GeneticAlgorithm::getReporter() const
+{
+	return reporter;
+}
+
+void GeneticAlgorithm::setVerbose(bool in_verbose)
+{
+	verbose = in_verbose;
+}
+
+Population * GeneticAlgorithm::getPopulation() const
+{
+	return pop;
+}
+
+unsigned int GeneticAlgorithm::getGeneration() const
+{
+	return current_generation;
+}
+
+const Statistics & GeneticAlgorithm::getStatistics() const
+{
+	return *stats;
+}
+
+Termination & GeneticAlgorithm::getTermination()
+{
+	return *termination;
 }
 
 bool GeneticAlgorithm::terminateUponGeneration()
 {
-	return (current_generation >= total_generations);
+	return termination->isGenerationLimitMet(current_generation);
 }
 
 bool GeneticAlgorithm::terminateUponConvergence()
 {
-	return true;
+	return termination->isConvergenceMet(*stats);
+}
+
+bool GeneticAlgorithm::terminateUponBudget()
+{
+	return termination->isBudgetMet(*stats);
 }
 
 ostream & operator<<(std::ostream & os, const GeneticAlgorithm & ga)
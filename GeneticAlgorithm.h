@@ -16,9 +16,15 @@
  *  \date 12 April 2006
  */
 
+#include <vector>
+
 #include "config.h"
 class Statistics;
 class Population;
+class Migration;
+class Reporter;
+class Observer;
+class Termination;
 
 
 
@@ -64,7 +70,8 @@ public:
 	virtual void nextGeneration() = 0;
 
 	/**
-	* Will call the appropriete termination function and check if its done or not.
+	* Will call the termination functions and check if its done or not. It is called after
+	* the statistics have been updated for the current generation.
 	* \note This is a virtual function and can be overridden in the derived classes.
 	*/
 	virtual bool isFinished();
@@ -74,6 +81,67 @@ public:
 	*/
 	virtual void evolve();
 
+	/**
+	* Sets the hook called after every generation. It is not owned by the genetic algorithm.
+	* \param in_migration is the hook, or 0 for none.
+	*/
+	void setMigration(Migration *in_migration);
+	/**
+	* Gets the hook called after every generation.
+	* \return the hook, or 0 if there is none.
+	*/
+	Migration * getMigration() const;
+
+	/**
+	* Sets the reporter evolve() publishes the metrics of every generation to. It is not owned
+	* by the genetic algorithm.
+	* \param in_reporter is the reporter, or 0 for none.
+	*/
+	void setReporter(Reporter *in_reporter);
+	/**
+	* Gets the reporter evolve() publishes to.
+	* \return the reporter, or 0 if there is none.
+	*/
+	Reporter * getReporter() const;
+
+	/**
+	* Adds an observer that evolve() tells about the run. It is not owned by the genetic algorithm.
+	* \param observer is the observer.
+	*/
+	void addObserver(Observer *observer);
+	/**
+	* Removes an observer added with addObserver().
+	* \param observer is the observer.
+	*/
+	void removeObserver(Observer *observer);
+	/**
+	* Ends evolve() before another generation is made. It is meant to be called by an observer.
+	*/
+	void stop();
+
+	/**
+	* Sets if evolve() writes out the statistics at the end, and every generation in full
+	* when there is no reporter.
+	* \param in_verbose is false to run silently. It defaults to true.
+	*/
+	void setVerbose(bool in_verbose);
+
+	/**
+	* Gets the population being evolved.
+	* \return a pointer to the population.
+	*/
+	Population * getPopulation() const;
+	/**
+	* Gets the current generation.
+	* \return the number of generations made so far.
+	*/
+	unsigned int getGeneration() const;
+	/**
+	* Gets the statistics of the run, including the metrics of each generation.
+	* \return a reference to the statistics.
+	*/
+	const Statistics & getStatistics() const;
+
 	/**
 	* Sorts the population based on the SORT_ORDER and SORT_TYPE.
 	*/
@@ -85,16 +153,28 @@ public:
 	//void setDefaultConfig();
 
 	/**
-	* This function is used if terminate upon generation is used.
+	* Gets the rules that end the run, so they can be changed before evolve() is called.
+	* \return a reference to the termination rules.
+	*/
+	Termination & getTermination();
+
+	/**
+	* This function checks the generation limit of the termination rules.
 	* It will run the algorithm until a set number of generations have passed.
 	* \return true is termination condition is met. Return false otherwise.
 	*/
 	bool terminateUponGeneration();
 	/**
-	* This function is used if terminate upon convergence is used.
+	* This function checks if the population has converged: the best genome has stopped
+	* improving, or improves too slowly, or the diversity has collapsed.
 	* \return true is termination condition is met. Return false otherwise.
 	*/
 	bool terminateUponConvergence();
+	/**
+	* This function checks the target score, time limit and evaluation limit of the termination rules.
+	* \return true is termination condition is met. Return false otherwise.
+	*/
+	bool terminateUponBudget();
 
 	/**
 	* Output operator. Prints out the genetic algoirthm to an output stream.
@@ -111,9 +191,33 @@ protected:
 	*/
 	Statistics *stats;
 	/**
+	* termination is a pointer to the rules that end the run.
+	*/
+	Termination *termination;
+	/**
 	* The current generation the algorithm is at.
 	*/
 	unsigned int current_generation;
+	/**
+	* The hook called after every generation, 0 if there is none.
+	*/
+	Migration *migration;
+	/**
+	* The reporter the metrics of every generation are published to, 0 if there is none.
+	*/
+	Reporter *reporter;
+	/**
+	* The observers told about the run, none by default.
+	*/
+	std::vector<Observer *> observers;
+	/**
+	* True if evolve() writes out the statistics, and every generation when there is no reporter.
+	*/
+	bool verbose;
+	/**
+	* True when stop() has been called during evolve().
+	*/
+	bool stop_requested;
 };
 
 #endif
\ No newline at end of file
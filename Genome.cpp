@@ -5,12 +5,14 @@
 using namespace std;
 
 Genome::Genome()
+	: genome_score(0.0), genome_fitness(0.0), evaluated(false), pop_slot(-1)
 {
 
 }
 
 Genome::Genome(const Genome & other)
-	: genome_score(other.genome_score), genome_fitness(other.genome_fitness)
+	: genome_score(other.genome_score), genome_fitness(other.genome_fitness), evaluated(other.evaluated),
+	  pop_slot(-1)
 {
 	
 }
@@ -24,6 +26,7 @@ void Genome::copy(const Genome & orig)
 {
 	genome_score = orig.genome_score;
 	genome_fitness = orig.genome_fitness;
+	evaluated = orig.evaluated;
 }
 
 double Genome::getScore() const
@@ -39,6 +42,7 @@ double Genome::getFitness() const
 void Genome::setScore(double score)
 {
 	genome_score = score;
+	evaluated = true;
 }
 
 void Genome::setFitness(double fitness)
@@ -46,6 +50,53 @@ void Genome::setFitness(double fitness)
 	genome_fitness = fitness;
 }
 
+bool Genome::isEvaluated() const
+{
+	return evaluated;
+}
+
+void Genome::invalidateScore()
+{
+	evaluated = false;
+}
+
+int Genome::getSlot() const
+{
+	return pop_slot;
+}
+
+void Genome::setSlot(int slot)
+{
+	pop_slot = slot;
+}
+
+void Genome::crossover(const Genome & parent2, Genome & child, Random & rng)
+{
+	Genome *offspring = crossover(parent2, rng);
+	child.copy(*offspring);
+	delete offspring;
+}
+
+double Genome::distance(const Genome & other) const
+{
+	return (genome_score == other.genome_score) ? 0.0 : 1.0;
+}
+
+unsigned int Genome::packedSize() const
+{
+	return 0;
+}
+
+void Genome::pack(char *) const
+{
+
+}
+
+bool Genome::unpack(const char *, unsigned int)
+{
+	return false;
+}
+
 ostream & operator<<(std::ostream & os, const Genome & g)
 {
 	os << "Genome Score: " << g.genome_score << endl;
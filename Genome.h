@@ -7,6 +7,8 @@
  * \date 8 April 2006
  */
 
+class Random;
+
 /**
  * This is an Abstract Data Type. This class is used to represent a genome.
  * It cannot be instantiated.
@@ -36,7 +38,8 @@ public:
 	 */
 	virtual Genome * clone() = 0;
 	/**
-	 * Virtual function to copy a genome.
+	 * Virtual function to copy a genome. Derived classes with data of their own must
+	 * override it so a genome can be overwritten with another one in place.
 	 * \param orig is the genome to copy.
 	 */
 	virtual void copy(const Genome & orig);
@@ -46,19 +49,61 @@ public:
 	virtual void evaluate() = 0;
 	/**
 	 * Pure virtual function to initialize a genome. It must be defined in derived classes.
+	 * \param rng is the random number generator to draw from.
 	 */
-	virtual void initialize() = 0;
+	virtual void initialize(Random & rng) = 0;
 
 	/**
 	 * Pure virtual function to mutate a genome. It must be defined in derived classes.
+	 * \param rng is the random number generator to draw from. Several genomes may be mutated
+	 * at once on different threads, each with its own generator.
 	 */
-	virtual void mutate() = 0;
+	virtual void mutate(Random & rng) = 0;
 	/**
 	 * Pure virtual function to crossover two genomes. It must be defined in derived classes.
+	 * Both parents are only read, so several crossovers may run at once on different threads.
 	 * \param parent2 is the other Genome that will be crossing over to generate a child.
+	 * \param rng is the random number generator to draw from.
 	 * \return a pointer to the newly created child genome.
 	 */
-	virtual Genome * crossover(const Genome & parent2) = 0;
+	virtual Genome * crossover(const Genome & parent2, Random & rng) = 0;
+	/**
+	 * Virtual function to crossover two genomes into an existing genome, so the storage of
+	 * old genomes can be reused. The default makes a new child with crossover() and copies
+	 * it over child, derived classes should override it to work in place.
+	 * \param parent2 is the other Genome that will be crossing over to generate a child.
+	 * \param child is the genome to overwrite with the child. It must not be a parent.
+	 * \param rng is the random number generator to draw from.
+	 */
+	virtual void crossover(const Genome & parent2, Genome & child, Random & rng);
+
+	/**
+	 * Virtual function to measure how different two genomes are. The default can only
+	 * tell genomes apart by their scores, derived classes should compare their genes.
+	 * \param other is the genome to compare with.
+	 * \return a distance from 0 for the same genome to 1 for nothing in common.
+	 */
+	virtual double distance(const Genome & other) const;
+
+	/**
+	 * Virtual function to get the number of bytes pack() writes. Derived classes that can be
+	 * sent to another process override it and pack() and unpack().
+	 * \return the number of bytes, or 0 if the genome cannot be packed.
+	 */
+	virtual unsigned int packedSize() const;
+	/**
+	 * Virtual function to write the genome and its score into a flat buffer, so it can be
+	 * sent to another process.
+	 * \param buffer is where to write, at least packedSize() bytes.
+	 */
+	virtual void pack(char *buffer) const;
+	/**
+	 * Virtual function to read a genome written by pack() into this one.
+	 * \param buffer is where to read from.
+	 * \param size is the number of bytes in buffer.
+	 * \return true if buffer held a genome this one can become.
+	 */
+	virtual bool unpack(const char *buffer, unsigned int size);
 
 	/**
 	 * Gets the score of the genome.
@@ -71,7 +116,7 @@ public:
 	 */
 	double getFitness() const;
 	/**
-	 * Sets the score of the genome.
+	 * Sets the score of the genome. The genome counts as evaluated from then on.
 	 * \param score is the genomes score.
 	 */
 	void setScore(double score);
@@ -81,6 +126,30 @@ public:
 	 */
 	void setFitness(double fitness);	
 
+	/**
+	 * Checks if the score of the genome is up to date. The population only evaluates
+	 * genomes that are not.
+	 * \returns true if the genome does not need to be evaluated.
+	 */
+	bool isEvaluated() const;
+	/**
+	 * Marks the score of the genome as out of date. Mutation and crossover must call this
+	 * when they change a genome without updating its score.
+	 */
+	void invalidateScore();
+
+	/**
+	 * Gets the slot of the genome in its population. The population keeps the scores
+	 * and fitnesses of its genomes in arrays indexed by this slot.
+	 * \returns the slot, or -1 if the genome is not in a population.
+	 */
+	int getSlot() const;
+	/**
+	 * Sets the slot of the genome in its population. This is done by the population.
+	 * \param slot is the index of the genome in the population.
+	 */
+	void setSlot(int slot);
+
 	/**
 	 * Outpur operater for the genome.
 	 * \param os is an output stream.
@@ -98,6 +167,14 @@ private:
 	 * Genomes fitness
 	 */
 	double genome_fitness;
+	/**
+	 * True when the score matches the genome.
+	 */
+	bool evaluated;
+	/**
+	 * The genomes slot in its population, -1 if it is not in one.
+	 */
+	int pop_slot;
 };
 
 #endif
\ No newline at end of file
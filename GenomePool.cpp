@@ -0,0 +1,53 @@
+#include <iostream>
+
+#include "GenomePool.h"
+#include "Genome.h"
+
+using namespace std;
+
+GenomePool::GenomePool()
+{
+
+}
+
+GenomePool::~GenomePool()
+{
+	for(vector<Genome *>::iterator it = free_genomes.begin();
+		it != free_genomes.end();
+		++it)
+	{
+		delete *it;
+	}
+}
+
+Genome * GenomePool::acquire(Genome & prototype)
+{
+	if(free_genomes.empty())
+		return prototype.clone();
+
+	Genome *genome = free_genomes.back();
+	free_genomes.pop_back();
+	return genome;
+}
+
+void GenomePool::release(Genome *genome)
+{
+	genome->setSlot(-1);
+	free_genomes.push_back(genome);
+}
+
+void GenomePool::release(vector<Genome *> & genomes)
+{
+	for(vector<Genome *>::iterator it = genomes.begin();
+		it != genomes.end();
+		++it)
+	{
+		release(*it);
+	}
+	genomes.clear();
+}
+
+unsigned int GenomePool::getNumFree() const
+{
+	return (unsigned int)free_genomes.size();
+}
@@ -0,0 +1,71 @@
+#ifndef GENOMEPOOL_H
+#define GENOMEPOOL_H
+
+/**
+ * \file GenomePool.h
+ */
+
+#include <vector>
+
+class Genome;
+
+/**
+ * This class keeps genomes that are no longer in a population so they can be used again
+ * instead of being deleted and allocated every generation. A recycled genome keeps the
+ * storage it had, so once the pool has warmed up overwriting it with a genome of the
+ * same problem does not allocate.
+ */
+class GenomePool
+{
+public:
+	/**
+	 * Default constructor. The pool is empty.
+	 */
+	GenomePool();
+	/**
+	 * Destructor. Deletes the genomes in the pool.
+	 */
+	~GenomePool();
+
+	/**
+	 * Takes a genome out of the pool, or clones prototype if the pool is empty. What the
+	 * genome holds is left over from its last use, so it must be overwritten with copy()
+	 * or crossover() before it is used.
+	 * \param prototype is a genome of the kind wanted.
+	 * \return a genome the caller owns until it is released.
+	 */
+	Genome * acquire(Genome & prototype);
+	/**
+	 * Gives a genome back to the pool.
+	 * \param genome is the genome. The pool owns it from now on.
+	 */
+	void release(Genome *genome);
+	/**
+	 * Gives genomes back to the pool.
+	 * \param genomes are the genomes. The vector is emptied but keeps its capacity.
+	 */
+	void release(std::vector<Genome *> & genomes);
+
+	/**
+	 * Gets the number of genomes waiting in the pool.
+	 * \return the number of genomes.
+	 */
+	unsigned int getNumFree() const;
+
+private:
+	/**
+	 * The pool cannot be copied.
+	 */
+	GenomePool(const GenomePool & other);
+	/**
+	 * The pool cannot be assigned.
+	 */
+	GenomePool & operator=(const GenomePool & other);
+
+	/**
+	 * The genomes waiting to be used again.
+	 */
+	std::vector<Genome *> free_genomes;
+};
+
+#endif
@@ -0,0 +1,197 @@
+#include <iostream>
+#include <thread>
+
+#include "IslandGA.h"
+#include "SteadyStateGA.h"
+#include "Population.h"
+#include "Genome.h"
+#include "Migration.h"
+#include "MigrantMailbox.h"
+#include "Random.h"
+
+using namespace std;
+
+// the migration hook of one island. It runs on the island's own thread.
+class IslandMigration : public Migration
+{
+public:
+	IslandMigration(vector<MigrantMailbox *> & in_mailboxes, int in_island, int in_topology,
+		unsigned int in_interval, unsigned int in_num_migrants, unsigned long long seed)
+		: mailboxes(in_mailboxes), island(in_island), topology(in_topology),
+		  interval(in_interval), num_migrants(in_num_migrants), rng(seed) {}
+	void migrate(GeneticAlgorithm & ga)
+	{
+		int num_islands = (int)mailboxes.size();
+		if(num_islands < 2 || interval == 0 || ga.getGeneration() % interval != 0)
+			return;
+
+		Population *pop = ga.getPopulation();
+
+		// send copies of the best genomes on
+		int destination = chooseDestination(island, num_islands, topology, rng);
+
+		unsigned int num_sent = num_migrants < (unsigned int)pop->getPopSize() ? num_migrants : pop->getPopSize();
+		pop->sortElite(num_sent);
+		for(unsigned int i = 0; i < num_sent; ++i)
+			mailboxes[destination]->post(pop->getGenome(i)->clone());
+
+		// take in whatever has arrived since last time in place of the worst genomes
+		mailboxes[island]->collect(arrivals);
+		if(!arrivals.empty())
+		{
+			pop->replaceWorst(arrivals);
+			ga.init();
+		}
+	}
+private:
+	vector<MigrantMailbox *> & mailboxes;
+	int island;
+	int topology;
+	unsigned int interval;
+	unsigned int num_migrants;
+	Random rng;
+	vector<Genome *> arrivals;
+};
+
+IslandGA::IslandGA()
+	: topology(MIGRATION_TOPOLOGY), migration_interval(MIGRATION_INTERVAL), num_migrants(NUM_MIGRANTS)
+{
+	Random seeder;
+	topology_seed = seeder.randomBits();
+}
+
+IslandGA::~IslandGA()
+{
+	for(vector<SteadyStateGA *>::iterator it = islands.begin();
+		it != islands.end();
+		++it)
+	{
+		delete *it;
+	}
+}
+
+void IslandGA::addIsland(SteadyStateGA *island)
+{
+	islands.push_back(island);
+}
+
+int IslandGA::getNumIslands() const
+{
+	return (int)islands.size();
+}
+
+SteadyStateGA * IslandGA::getIsland(int index) const
+{
+	return islands[index];
+}
+
+void IslandGA::setTopology(int in_topology)
+{
+	topology = in_topology;
+}
+
+int IslandGA::getTopology() const
+{
+	return topology;
+}
+
+void IslandGA::setMigrationInterval(unsigned int interval)
+{
+	migration_interval = interval;
+}
+
+unsigned int IslandGA::getMigrationInterval() const
+{
+	return migration_interval;
+}
+
+void IslandGA::setNumMigrants(unsigned int num)
+{
+	num_migrants = num;
+}
+
+unsigned int IslandGA::getNumMigrants() const
+{
+	return num_migrants;
+}
+
+void IslandGA::setSeed(unsigned long long seed)
+{
+	Random seeder(seed);
+	topology_seed = seeder.randomBits();
+	for(vector<SteadyStateGA *>::iterator it = islands.begin();
+		it != islands.end();
+		++it)
+	{
+		(*it)->setSeed(seeder.randomBits());
+	}
+}
+
+void IslandGA::evolve()
+{
+	int num_islands = (int)islands.size();
+
+	for(int i = 0; i < num_islands; ++i)
+		mailboxes.push_back(new MigrantMailbox());
+
+	Random seeder(topology_seed);
+	for(int i = 0; i < num_islands; ++i)
+	{
+		migrations.push_back(new IslandMigration(mailboxes, i, topology, migration_interval,
+			num_migrants, seeder.randomBits()));
+		islands[i]->setMigration(migrations[i]);
+		islands[i]->setVerbose(false);
+	}
+
+	// this thread runs the first island itself
+	vector<thread> threads;
+	for(int i = 1; i < num_islands; ++i)
+		threads.push_back(thread(&GeneticAlgorithm::evolve, islands[i]));
+	if(num_islands > 0)
+		islands[0]->evolve();
+
+	for(vector<thread>::iterator it = threads.begin();
+		it != threads.end();
+		++it)
+	{
+		it->join();
+	}
+
+	// migrants that were never taken in are deleted with their mailbox
+	for(int i = 0; i < num_islands; ++i)
+	{
+		islands[i]->setMigration(0);
+		delete migrations[i];
+		delete mailboxes[i];
+	}
+	migrations.clear();
+	mailboxes.clear();
+}
+
+Genome & IslandGA::getBestGenome() const
+{
+	int best = 0;
+	for(int i = 1; i < (int)islands.size(); ++i)
+	{
+		double score = islands[i]->getPopulation()->getBestGenome().getScore();
+		double best_score = islands[best]->getPopulation()->getBestGenome().getScore();
+		if(HIGH_LOW == HIGH_IS_BEST ? score > best_score : score < best_score)
+			best = i;
+	}
+	return islands[best]->getPopulation()->getBestGenome();
+}
+
+ostream & operator<<(std::ostream & os, const IslandGA & island_ga)
+{
+	os << "**********************************************************" << endl;
+	os << "                    " << island_ga.getNumIslands() << " Islands" << endl;
+	os << "**********************************************************" << endl;
+	for(int i = 0; i < island_ga.getNumIslands(); ++i)
+	{
+		os << "Island " << i << " Best Score: "
+			<< island_ga.getIsland(i)->getPopulation()->getBestGenome().getScore() << endl;
+	}
+	os << ">> Best Genome <<" << endl;
+	os << island_ga.getBestGenome() << endl;
+	return os;
+}
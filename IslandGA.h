@@ -0,0 +1,153 @@
+#ifndef ISLANDGA_H
+#define ISLANDGA_H
+
+/**
+ * \file IslandGA.h
+ */
+
+#include "config.h"
+#include <vector>
+#include <iostream>
+
+class SteadyStateGA;
+class Genome;
+class Migration;
+class MigrantMailbox;
+
+/**
+ * This class runs several genetic algorithms, the islands, at once, each on its own thread.
+ * Every MIGRATION_INTERVAL generations each island sends copies of its best genomes to
+ * another island, which takes them in place of its worst. Islands never wait for each
+ * other: migrants are left in the lock-free mailbox of the island they go to and it takes
+ * them in the next time it migrates.
+ */
+class IslandGA
+{
+public:
+	/**
+	 * Default constructor. There are no islands until they are added.
+	 */
+	IslandGA();
+	/**
+	 * Destructor. Deletes the islands.
+	 */
+	~IslandGA();
+
+	/**
+	 * Adds an island. Every island should have its own population of the same problem.
+	 * \param island is the genetic algorithm of the island. The IslandGA owns it.
+	 */
+	void addIsland(SteadyStateGA *island);
+	/**
+	 * Gets the number of islands.
+	 * \return the number of islands.
+	 */
+	int getNumIslands() const;
+	/**
+	 * Gets an island.
+	 * \param index is the index of the island.
+	 * \return a pointer to the genetic algorithm of the island.
+	 */
+	SteadyStateGA * getIsland(int index) const;
+
+	/**
+	 * Sets where the migrants of each island go.
+	 * \param in_topology is RING_TOPOLOGY to send to the next island, or RANDOM_TOPOLOGY to
+	 * send to a different island picked at random each time. It defaults to MIGRATION_TOPOLOGY.
+	 */
+	void setTopology(int in_topology);
+	/**
+	 * Gets where the migrants of each island go.
+	 * \return RING_TOPOLOGY or RANDOM_TOPOLOGY.
+	 */
+	int getTopology() const;
+	/**
+	 * Sets how often the islands migrate.
+	 * \param interval is the number of generations between migrations. It defaults to MIGRATION_INTERVAL.
+	 */
+	void setMigrationInterval(unsigned int interval);
+	/**
+	 * Gets how often the islands migrate.
+	 * \return the number of generations between migrations.
+	 */
+	unsigned int getMigrationInterval() const;
+	/**
+	 * Sets how many genomes each island sends when it migrates.
+	 * \param num is the number of migrants. It defaults to NUM_MIGRANTS.
+	 */
+	void setNumMigrants(unsigned int num);
+	/**
+	 * Gets how many genomes each island sends when it migrates.
+	 * \return the number of migrants.
+	 */
+	unsigned int getNumMigrants() const;
+
+	/**
+	 * Seeds every island and the choice of random destinations.
+	 * The islands get different seeds derived from this one.
+	 * \param seed is the seed.
+	 */
+	void setSeed(unsigned long long seed);
+
+	/**
+	 * Evolves every island on its own thread until each one is finished.
+	 * The islands run silently.
+	 */
+	void evolve();
+
+	/**
+	 * Gets the best genome of all the islands.
+	 * \return a reference to the best genome.
+	 */
+	Genome & getBestGenome() const;
+
+	/**
+	 * Output operator. Prints out the best score of each island and the best genome.
+	 * \param os is an output stream.
+	 * \param island_ga is the island genetic algorithm to output.
+	 * \return the output stream.
+	 */
+	friend std::ostream & operator<<(std::ostream & os, const IslandGA & island_ga);
+
+private:
+	/**
+	 * The islands cannot be copied.
+	 */
+	IslandGA(const IslandGA & other);
+	/**
+	 * The islands cannot be assigned.
+	 */
+	IslandGA & operator=(const IslandGA & other);
+
+	/**
+	 * The genetic algorithm of each island.
+	 */
+	std::vector<SteadyStateGA *> islands;
+	/**
+	 * Where each island finds the genomes sent to it, indexed like the islands.
+	 */
+	std::vector<MigrantMailbox *> mailboxes;
+	/**
+	 * The migration hook of each island, indexed like the islands.
+	 */
+	std::vector<Migration *> migrations;
+
+	/**
+	 * RING_TOPOLOGY or RANDOM_TOPOLOGY.
+	 */
+	int topology;
+	/**
+	 * The number of generations between migrations.
+	 */
+	unsigned int migration_interval;
+	/**
+	 * The number of genomes each island sends when it migrates.
+	 */
+	unsigned int num_migrants;
+	/**
+	 * The seed each island's choice of destinations is derived from.
+	 */
+	unsigned long long topology_seed;
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cassert>
+
+#include "MetricHistory.h"
+
+using namespace std;
+
+// Statistics, the reporter and the termination rules read the newest generation it records
+static_assert(METRIC_HISTORY_SIZE > 0, "METRIC_HISTORY_SIZE must keep at least one generation");
+
+MetricHistory::MetricHistory(unsigned int in_capacity)
+	: next(0), count(0)
+{
+	// a history that kept nothing would have no newest generation to give back
+	unsigned int cap = (in_capacity > 0) ? in_capacity : 1;
+	generations.resize(cap);
+	best_scores.resize(cap);
+	mean_scores.resize(cap);
+	worst_scores.resize(cap);
+	score_stddevs.resize(cap);
+	diversities.resize(cap);
+	evaluations.resize(cap);
+	wall_times.resize(cap);
+}
+
+MetricHistory::~MetricHistory()
+{
+
+}
+
+void MetricHistory::record(const GenerationMetrics & metrics)
+{
+	generations[next] = metrics.generation;
+	best_scores[next] = metrics.best_score;
+	mean_scores[next] = metrics.mean_score;
+	worst_scores[next] = metrics.worst_score;
+	score_stddevs[next] = metrics.score_stddev;
+	diversities[next] = metrics.diversity;
+	evaluations[next] = metrics.evaluations;
+	wall_times[next] = metrics.wall_time;
+
+	next = (next + 1 == generations.size()) ? 0 : next + 1;
+	if(count < generations.size())
+		++count;
+}
+
+void MetricHistory::clear()
+{
+	next = 0;
+	count = 0;
+}
+
+unsigned int MetricHistory::size() const
+{
+	return count;
+}
+
+unsigned int MetricHistory::capacity() const
+{
+	return (unsigned int)generations.size();
+}
+
+unsigned int MetricHistory::position(unsigned int index) const
+{
+	// the oldest generation is at next once the ring has wrapped, at 0 before
+	unsigned int first = (count < generations.size()) ? 0 : next;
+	unsigned int pos = first + index;
+	return (pos >= generations.size()) ? pos - (unsigned int)generations.size() : pos;
+}
+
+GenerationMetrics MetricHistory::get(unsigned int index) const
+{
+	assert(index < count && "no such generation in the history");
+	unsigned int pos = position(index);
+
+	GenerationMetrics metrics;
+	metrics.generation = generations[pos];
+	metrics.best_score = best_scores[pos];
+	metrics.mean_score = mean_scores[pos];
+	metrics.worst_score = worst_scores[pos];
+	metrics.score_stddev = score_stddevs[pos];
+	metrics.diversity = diversities[pos];
+	metrics.evaluations = evaluations[pos];
+	metrics.wall_time = wall_times[pos];
+	return metrics;
+}
+
+GenerationMetrics MetricHistory::last() const
+{
+	return get(count - 1);
+}
+
+void MetricHistory::writeCSV(ostream & os) const
+{
+	os << "generation,best,mean,worst,stddev,diversity,evaluations,wall_time\n";
+	os << setprecision(17);
+	for(unsigned int i = 0; i < count; ++i)
+	{
+		unsigned int pos = position(i);
+		os << generations[pos] << ',' << best_scores[pos] << ',' << mean_scores[pos] << ','
+			<< worst_scores[pos] << ',' << score_stddevs[pos] << ',' << diversities[pos] << ','
+			<< evaluations[pos] << ',' << wall_times[pos] << '\n';
+	}
+}
+
+template <typename T>
+void MetricHistory::writeColumn(ostream & os, const vector<T> & column) const
+{
+	if(count == 0)
+		return;
+
+	// the ring is at most two runs of the array
+	unsigned int first = position(0);
+	unsigned int first_run = (first + count <= column.size()) ? count : (unsigned int)column.size() - first;
+	os.write((const char *)&column[first], first_run * sizeof(T));
+	if(first_run < count)
+		os.write((const char *)&column[0], (count - first_run) * sizeof(T));
+}
+
+void MetricHistory::writeBinary(ostream & os) const
+{
+	unsigned int version = 1;
+	os.write("GAMH", 4);
+	os.write((const char *)&version, sizeof(version));
+	os.write((const char *)&count, sizeof(count));
+
+	writeColumn(os, generations);
+	writeColumn(os, best_scores);
+	writeColumn(os, mean_scores);
+	writeColumn(os, worst_scores);
+	writeColumn(os, score_stddevs);
+	writeColumn(os, diversities);
+	writeColumn(os, evaluations);
+	writeColumn(os, wall_times);
+}
+
+bool MetricHistory::saveCSV(const string & filename) const
+{
+	ofstream file(filename.c_str());
+	if(!file)
+		return false;
+	writeCSV(file);
+	return (bool)file;
+}
+
+bool MetricHistory::saveBinary(const string & filename) const
+{
+	ofstream file(filename.c_str(), ios::binary);
+	if(!file)
+		return false;
+	writeBinary(file);
+	return (bool)file;
+}
@@ -0,0 +1,166 @@
+#ifndef METRICHISTORY_H
+#define METRICHISTORY_H
+
+/**
+ * \file MetricHistory.h
+ */
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include "config.h"
+
+/**
+ * The metrics of one generation.
+ */
+struct GenerationMetrics
+{
+	/**
+	 * The generation the metrics are for.
+	 */
+	unsigned int generation;
+	/**
+	 * The score of the best genome.
+	 */
+	double best_score;
+	/**
+	 * The average score.
+	 */
+	double mean_score;
+	/**
+	 * The score of the worst genome.
+	 */
+	double worst_score;
+	/**
+	 * The standard deviation of the scores.
+	 */
+	double score_stddev;
+	/**
+	 * The diversity of the population, see Population::getDiversity().
+	 */
+	double diversity;
+	/**
+	 * The number of genome evaluations done so far.
+	 */
+	unsigned long long evaluations;
+	/**
+	 * The number of seconds since the run started.
+	 */
+	double wall_time;
+};
+
+/**
+ * This class is a history of the metrics of each generation. It holds a fixed number of
+ * generations in a ring: once it is full each new generation replaces the oldest, so the
+ * memory used does not grow however long the run. Each metric is kept in its own array.
+ */
+class MetricHistory
+{
+public:
+	/**
+	 * Default constructor. All the memory the history needs is allocated here.
+	 * \param in_capacity is the number of generations kept. It defaults to METRIC_HISTORY_SIZE,
+	 * and 0 is taken as 1.
+	 */
+	MetricHistory(unsigned int in_capacity = METRIC_HISTORY_SIZE);
+	/**
+	 * Destructor.
+	 */
+	~MetricHistory();
+
+	/**
+	 * Adds the metrics of a generation, dropping the oldest if the history is full.
+	 * \param metrics are the metrics.
+	 */
+	void record(const GenerationMetrics & metrics);
+	/**
+	 * Removes every generation.
+	 */
+	void clear();
+
+	/**
+	 * Gets the number of generations in the history.
+	 * \return the number of generations, no more than the capacity.
+	 */
+	unsigned int size() const;
+	/**
+	 * Gets the number of generations the history can hold.
+	 * \return the capacity.
+	 */
+	unsigned int capacity() const;
+	/**
+	 * Gets the metrics of a generation in the history.
+	 * \param index is 0 for the oldest generation kept, up to size() - 1 for the newest.
+	 * It must be less than size().
+	 * \return the metrics.
+	 */
+	GenerationMetrics get(unsigned int index) const;
+	/**
+	 * Gets the metrics of the newest generation.
+	 * \return the metrics. The history must not be empty.
+	 */
+	GenerationMetrics last() const;
+
+	/**
+	 * Writes the history as comma separated values with a header line, oldest first.
+	 * \param os is the output stream.
+	 */
+	void writeCSV(std::ostream & os) const;
+	/**
+	 * Writes the history in binary, oldest first. The format is the 4 characters "GAMH",
+	 * the version (1) and the number of generations as 32 bit integers, then each column in
+	 * turn: the generations as 32 bit integers, the best, mean and worst scores, the
+	 * standard deviations and the diversities as doubles, the evaluations as 64 bit integers
+	 * and the wall times as doubles. Everything is in the byte order of the machine.
+	 * \param os is the output stream. It should be opened in binary mode.
+	 */
+	void writeBinary(std::ostream & os) const;
+	/**
+	 * Writes the history to a CSV file.
+	 * \param filename is the name of the file.
+	 * \return true if the file was written.
+	 */
+	bool saveCSV(const std::string & filename) const;
+	/**
+	 * Writes the history to a binary file.
+	 * \param filename is the name of the file.
+	 * \return true if the file was written.
+	 */
+	bool saveBinary(const std::string & filename) const;
+
+private:
+	/**
+	 * Gets the position in the arrays of a generation in the history.
+	 * \param index is 0 for the oldest generation kept.
+	 * \return the position in the arrays.
+	 */
+	unsigned int position(unsigned int index) const;
+	/**
+	 * Writes one column, oldest first.
+	 * \param os is the output stream.
+	 * \param column is the column.
+	 */
+	template <typename T>
+	void writeColumn(std::ostream & os, const std::vector<T> & column) const;
+
+	/**
+	 * The position the next generation is written to.
+	 */
+	unsigned int next;
+	/**
+	 * The number of generations in the history.
+	 */
+	unsigned int count;
+
+	std::vector<unsigned int> generations; /**< The generation column. */
+	std::vector<double> best_scores; /**< The best score column. */
+	std::vector<double> mean_scores; /**< The mean score column. */
+	std::vector<double> worst_scores; /**< The worst score column. */
+	std::vector<double> score_stddevs; /**< The standard deviation column. */
+	std::vector<double> diversities; /**< The diversity column. */
+	std::vector<unsigned long long> evaluations; /**< The evaluations column. */
+	std::vector<double> wall_times; /**< The wall time column. */
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <algorithm>
+
+#include "MigrantMailbox.h"
+#include "Genome.h"
+
+using namespace std;
+
+MigrantMailbox::MigrantMailbox()
+	: head(0)
+{
+
+}
+
+MigrantMailbox::~MigrantMailbox()
+{
+	vector<Genome *> left;
+	collect(left);
+	for(vector<Genome *>::iterator it = left.begin();
+		it != left.end();
+		++it)
+	{
+		delete *it;
+	}
+}
+
+void MigrantMailbox::post(Genome *genome)
+{
+	Node *node = new Node;
+	node->genome = genome;
+	node->next = head.load(memory_order_relaxed);
+
+	// on failure node->next is reloaded with the current head, so just try again
+	while(!head.compare_exchange_weak(node->next, node, memory_order_release, memory_order_relaxed))
+		;
+}
+
+void MigrantMailbox::collect(vector<Genome *> & genomes)
+{
+	// the collector takes the whole list, so a node is never popped while another
+	// thread is looking at it
+	Node *node = head.exchange(0, memory_order_acquire);
+
+	// the list is newest first, put the genomes out oldest first
+	size_t first = genomes.size();
+	while(node)
+	{
+		genomes.push_back(node->genome);
+		Node *next = node->next;
+		delete node;
+		node = next;
+	}
+	std::reverse(genomes.begin() + first, genomes.end());
+}
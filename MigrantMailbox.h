@@ -0,0 +1,68 @@
+#ifndef MIGRANTMAILBOX_H
+#define MIGRANTMAILBOX_H
+
+/**
+ * \file MigrantMailbox.h
+ */
+
+#include <vector>
+#include <atomic>
+
+class Genome;
+
+/**
+ * This class is where genomes migrating to an island wait until the island takes them in.
+ * Any number of threads can post to it at once and the island collects from it, all
+ * without locks: posting pushes onto a linked list with compare and swap, and collecting
+ * takes the whole list in one exchange.
+ */
+class MigrantMailbox
+{
+public:
+	/**
+	 * Default constructor. The mailbox is empty.
+	 */
+	MigrantMailbox();
+	/**
+	 * Destructor. Deletes any genomes that were never collected.
+	 */
+	~MigrantMailbox();
+
+	/**
+	 * Posts a genome to the mailbox. This can be called from any thread.
+	 * \param genome is the genome. The mailbox owns it until it is collected.
+	 */
+	void post(Genome *genome);
+	/**
+	 * Takes every genome in the mailbox. Only one thread may collect at a time.
+	 * \param genomes gets the genomes added to its end, in the order they were posted.
+	 * The caller owns them.
+	 */
+	void collect(std::vector<Genome *> & genomes);
+
+private:
+	/**
+	 * The mailbox cannot be copied.
+	 */
+	MigrantMailbox(const MigrantMailbox & other);
+	/**
+	 * The mailbox cannot be assigned.
+	 */
+	MigrantMailbox & operator=(const MigrantMailbox & other);
+
+	/**
+	 * A genome in the mailbox and the one posted before it.
+	 */
+	struct Node
+	{
+		Genome *genome;
+		Node *next;
+	};
+
+	/**
+	 * The genome posted last, 0 when the mailbox is empty.
+	 */
+	std::atomic<Node *> head;
+};
+
+#endif
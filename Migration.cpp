@@ -0,0 +1,21 @@
+#include <iostream>
+
+#include "Migration.h"
+#include "Random.h"
+#include "config.h"
+
+using namespace std;
+
+int Migration::chooseDestination(int island, int num_islands, int topology, Random & rng)
+{
+	if(topology == RANDOM_TOPOLOGY)
+	{
+		// any island but this one
+		int destination = rng.randomInt(num_islands - 1);
+		if(destination >= island)
+			++destination;
+		return destination;
+	}
+	else // if(topology == RING_TOPOLOGY)
+		return (island + 1) % num_islands;
+}
@@ -0,0 +1,45 @@
+#ifndef MIGRATION_H
+#define MIGRATION_H
+
+/**
+ * \file Migration.h
+ */
+
+class GeneticAlgorithm;
+class Random;
+
+/**
+ * This is an Abstract Data Type. It is a hook that a GeneticAlgorithm calls after every
+ * generation, so genomes can be sent to and taken in from other genetic algorithms.
+ * It cannot be instantiated.
+ */
+class Migration
+{
+public:
+	/**
+	 * Destructor.
+	 */
+	virtual ~Migration() {}
+
+	/**
+	 * Called by the genetic algorithm after each new generation has been initialized.
+	 * If genomes are taken into its population, the genetic algorithm must be
+	 * initialized again with init().
+	 * \param ga is the genetic algorithm that has made a new generation.
+	 */
+	virtual void migrate(GeneticAlgorithm & ga) = 0;
+
+protected:
+	/**
+	 * Picks the island an island sends its migrants to.
+	 * \param island is the index of the sending island.
+	 * \param num_islands is the number of islands, at least 2.
+	 * \param topology is RING_TOPOLOGY for the next island round the ring, or RANDOM_TOPOLOGY
+	 * for any island but the sender.
+	 * \param rng is the generator a random island is drawn from.
+	 * \return the index of the island to send to.
+	 */
+	static int chooseDestination(int island, int num_islands, int topology, Random & rng);
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef OBSERVER_H
+#define OBSERVER_H
+
+/**
+ * \file Observer.h
+ */
+
+class GeneticAlgorithm;
+class Genome;
+class Statistics;
+struct PopulationSummary;
+struct GenerationMetrics;
+
+/**
+ * This class watches a GeneticAlgorithm as it evolves. The genetic algorithm calls it with
+ * references to what it has already worked out, so watching costs no extra passes over the
+ * population. Each function does nothing unless it is overridden, so an observer only
+ * overrides the events it wants. An observer can end the run early with GeneticAlgorithm::stop().
+ */
+class Observer
+{
+public:
+	/**
+	 * Destructor.
+	 */
+	virtual ~Observer() {}
+
+	/**
+	 * Called once the statistics have been updated for a generation, before the next one is made.
+	 * \param ga is the genetic algorithm.
+	 * \param summary is the summary of the population.
+	 * \param metrics is the metrics of the generation just recorded.
+	 */
+	virtual void onGenerationEnd(GeneticAlgorithm &, const PopulationSummary &,
+		const GenerationMetrics &) {}
+	/**
+	 * Called when the genetic algorithm finds a better genome than any before, and once for
+	 * the best genome of the first population.
+	 * \param ga is the genetic algorithm.
+	 * \param best is the copy of the best genome the statistics keep.
+	 * \param generation is the generation it was found in.
+	 */
+	virtual void onNewBest(GeneticAlgorithm &, const Genome &, unsigned int) {}
+	/**
+	 * Called after the migration hook of the genetic algorithm has run.
+	 * \param ga is the genetic algorithm.
+	 */
+	virtual void onMigration(GeneticAlgorithm &) {}
+	/**
+	 * Called when the run has finished, before the statistics are written out.
+	 * \param ga is the genetic algorithm.
+	 * \param stats is the statistics of the run.
+	 */
+	virtual void onTermination(GeneticAlgorithm &, const Statistics &) {}
+};
+
+#endif
@@ -3,19 +3,30 @@
 #include "Population.h"
 #include "Genome.h"
 #include "Random.h"
+#include "ThreadPool.h"
 #include <vector>
+#include <algorithm>
+#include <cassert>
 
 using namespace std;
 
 Population::Population()
-	: pop_genomes(new vector<Genome *>), population_size(0), objRand(new Random())
+	: pop_genomes(new vector<Genome *>), summary_valid(false),
+	  population_size(0), evaluation_count(0), evaluation_pool(0),
+	  objRand(new Random()),
+	  selection_wheel_valid(false), selection_wheel_by_rank(false), tournament_size(TOURNAMENT_SIZE)
 {
-
+	setEvaluationThreads(EVALUATION_THREADS);
 }
 
 Population::Population(const Population & other)
-	: pop_genomes(new vector<Genome *>), population_size(other.population_size), objRand(new Random())
+	: pop_genomes(new vector<Genome *>), summary_valid(false),
+	  population_size(other.population_size), evaluation_count(0), evaluation_pool(0),
+	  objRand(new Random()),
+	  selection_wheel_valid(false), selection_wheel_by_rank(false), tournament_size(other.tournament_size)
 {
+	setEvaluationThreads(other.getEvaluationThreads());
+
 	for(vector<Genome *>::iterator it = other.pop_genomes->begin();
 		it != other.pop_genomes->end();
 		++it)
@@ -23,13 +34,17 @@ Population::Population(const Population & other)
 		pop_genomes->push_back((*it)->clone());
 	}
 
+	gatherGenomeValues();
 	updateBestWorst();
 }
 
 Population::Population(unsigned int pop_size)
-	: pop_genomes(new vector<Genome *>), population_size(pop_size), objRand(new Random())
+	: pop_genomes(new vector<Genome *>), summary_valid(false),
+	  population_size(pop_size), evaluation_count(0), evaluation_pool(0),
+	  objRand(new Random()),
+	  selection_wheel_valid(false), selection_wheel_by_rank(false), tournament_size(TOURNAMENT_SIZE)
 {
-
+	setEvaluationThreads(EVALUATION_THREADS);
 }
 
 Population::~Population()
@@ -42,6 +57,7 @@ Population::~Population()
 	}
 	delete pop_genomes;
 	delete objRand;
+	delete evaluation_pool;
 }
 
 Population * Population::clone() const
@@ -61,63 +77,194 @@ int Population::getPopSize() const
 
 double Population::getMaxScore() const
 {
-	double max = 0.0;
-	for(vector<Genome *>::const_iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
-	{
-		if((*it)->getScore() > max)
-			max = (*it)->getScore();
-	}
-	return max;
+	return getSummary().max_score;
 }
 
 double Population::getMinScore() const
 {
-	double min = getMaxScore();
-	for(vector<Genome *>::const_iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
+	return getSummary().min_score;
+}
+
+double Population::getAveScore() const
+{
+	return getSummary().ave_score;
+}
+
+double Population::getAveFitness() const
+{
+	return getSummary().ave_fitness;
+}
+
+const PopulationSummary & Population::getSummary() const
+{
+	if(summary_valid)
+		return summary;
+
+	int num_genomes = (int)genome_scores.size();
+
+	summary.total_score = 0.0;
+	summary.total_fitness = 0.0;
+	summary.ave_score = 0.0;
+	summary.ave_fitness = 0.0;
+	summary.min_score = 0.0;
+	summary.max_score = 0.0;
+	summary.score_variance = 0.0;
+	summary.best_index = -1;
+	summary.worst_index = -1;
+
+	if(num_genomes > 0)
 	{
-		if((*it)->getScore() < min)
-			min = (*it)->getScore();
+		int min_index = 0;
+		int max_index = 0;
+		double mean = 0.0;
+		double squares = 0.0; // sum of squared differences from the mean (Welford)
+
+		for(int i = 0; i < num_genomes; ++i)
+		{
+			double score = genome_scores[i];
+
+			summary.total_score += score;
+			summary.total_fitness += genome_fitnesses[i];
+			if(score < genome_scores[min_index])
+				min_index = i;
+			if(score > genome_scores[max_index])
+				max_index = i;
+
+			double delta = score - mean;
+			mean += delta / (i + 1);
+			squares += delta * (score - mean);
+		}
+
+		summary.ave_score = summary.total_score / num_genomes;
+		summary.ave_fitness = summary.total_fitness / num_genomes;
+		summary.min_score = genome_scores[min_index];
+		summary.max_score = genome_scores[max_index];
+		summary.score_variance = squares / num_genomes;
+		summary.best_index = (HIGH_LOW == HIGH_IS_BEST) ? max_index : min_index;
+		summary.worst_index = (HIGH_LOW == HIGH_IS_BEST) ? min_index : max_index;
 	}
-	return min;
+
+	summary_valid = true;
+	return summary;
 }
 
-double Population::getAveScore() const
+double Population::getScore(unsigned int slot) const
 {
-	double total = 0.0;
-	for(vector<Genome *>::const_iterator it = pop_genomes->begin();
+	return genome_scores[slot];
+}
+
+double Population::getFitness(unsigned int slot) const
+{
+	return genome_fitnesses[slot];
+}
+
+/**
+ * Evaluates a range of genomes. Each genome only writes its own score, so the ranges
+ * can be evaluated on different threads.
+ */
+class EvaluateTask : public ParallelTask
+{
+public:
+	EvaluateTask(vector<Genome *> & in_genomes) : genomes(in_genomes) {}
+	void run(int begin, int end, unsigned int)
+	{
+		for(int i = begin; i < end; ++i)
+			genomes[i]->evaluate();
+	}
+private:
+	vector<Genome *> & genomes;
+};
+
+void Population::evaluatePopulationScores()
+{
+	// genomes that have not changed since they were last evaluated are skipped
+	dirty_genomes.clear();
+	for(vector<Genome *>::iterator it = pop_genomes->begin();
 		it != pop_genomes->end();
 		++it)
 	{
-			total += (*it)->getScore();
+		if(!(*it)->isEvaluated())
+			dirty_genomes.push_back(*it);
 	}
-	return total/population_size;
+
+	EvaluateTask task(dirty_genomes);
+	if(evaluation_pool)
+		evaluation_pool->parallelFor(task, (int)dirty_genomes.size());
+	else
+		task.run(0, (int)dirty_genomes.size(), 0);
+
+	evaluation_count += dirty_genomes.size();
+
+	// from here on the scores are read from the array
+	gatherGenomeValues();
 }
 
-double Population::getAveFitness() const
+void Population::setEvaluationThreads(unsigned int num_threads)
+{
+	delete evaluation_pool;
+	evaluation_pool = (num_threads > 1) ? new ThreadPool(num_threads) : 0;
+}
+
+unsigned int Population::getEvaluationThreads() const
+{
+	return evaluation_pool ? evaluation_pool->getNumThreads() : 1;
+}
+
+unsigned long Population::getEvaluationCount() const
 {
+	return evaluation_count;
+}
+
+double Population::getDiversity(unsigned int samples) const
+{
+	int num_genomes = (int)pop_genomes->size();
+	if(num_genomes < 2 || samples == 0)
+		return 0.0;
+	if((int)samples > num_genomes - 1)
+		samples = num_genomes - 1;
+
+	const Genome & best = getBestGenome();
 	double total = 0.0;
-	for(vector<Genome *>::const_iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
+	for(unsigned int i = 0; i < samples; ++i)
 	{
-			total += (*it)->getFitness();
+		// spread the samples over the slots, stepping over the best genome itself
+		int slot = (int)(((long long)i * num_genomes) / samples);
+		if(slot == best.getSlot())
+			slot = (slot + 1) % num_genomes;
+		total += best.distance(*(*pop_genomes)[slot]);
 	}
-	return total/population_size;
+	return total / samples;
 }
 
-void Population::evaluatePopulationScores()
+void Population::setSeed(unsigned long long seed)
 {
-	for(vector<Genome *>::iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
-	{		
-		(*it)->evaluate();
+	objRand->seed(seed);
+}
+
+void Population::gatherGenomeValues()
+{
+	int num_genomes = (int)pop_genomes->size();
+	genome_scores.resize(num_genomes);
+	genome_fitnesses.resize(num_genomes);
+
+	for(int i = 0; i < num_genomes; ++i)
+	{
+		Genome *genome = (*pop_genomes)[i];
+		genome->setSlot(i);
+		genome_scores[i] = genome->getScore();
+		genome_fitnesses[i] = genome->getFitness();
 	}
+	summary_valid = false;
+}
+
+void Population::scatterFitnesses()
+{
+	int num_genomes = (int)pop_genomes->size();
+	for(int i = 0; i < num_genomes; ++i)
+		(*pop_genomes)[i]->setFitness(genome_fitnesses[i]);
 
+	selection_wheel_valid = false;
+	summary_valid = false;
 }
 
 void Population::evaluatePopulationFitnesses()
@@ -134,6 +281,9 @@ void Population::evaluatePopulationFitnesses()
 	{
 		rankScaling();
 	}
+
+	// the fitnesses are fixed for this generation now
+	buildSelectionWheel(SELECTION_SCHEME == RANK_SELECTION);
 }
 
 void Population::initialize()
@@ -150,44 +300,37 @@ Genome * Population::getGenome(unsigned int index)
 
 Genome & Population::getBestGenome() const
 {
-	return *best_genome;
+	int index = getSummary().best_index;
+	assert(index >= 0 && "the population is empty");
+	return *(*pop_genomes)[index];
 }
 
 Genome & Population::getWorstGenome() const
 {
-	return *worst_genome;
+	int index = getSummary().worst_index;
+	assert(index >= 0 && "the population is empty");
+	return *(*pop_genomes)[index];
 }
 
 void Population::addGenome(Genome *genome)
 {
+	genome->setSlot((int)pop_genomes->size());
 	pop_genomes->push_back(genome);
+	genome_scores.push_back(genome->getScore());
+	genome_fitnesses.push_back(genome->getFitness());
 	++population_size;
+	selection_wheel_valid = false;
+	summary_valid = false;
 }
 
 double Population::getTotalFitness() const
 {
-	double total = 0.0;
-	for(vector<Genome *>::iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
-	{
-		total += (*it)->getFitness();
-	}
-
-	return total;
+	return getSummary().total_fitness;
 }
 
 double Population::getTotalScore() const
 {
-	double total = 0.0;
-	for(vector<Genome *>::iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
-	{
-		total += (*it)->getScore();
-	}
-
-	return total;
+	return getSummary().total_score;
 }
 
 void Population::scale()
@@ -204,39 +347,62 @@ void Population::scale()
 
 void Population::noScaling()
 {
-	for(vector<Genome *>::iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
+	genome_fitnesses = genome_scores;
+	scatterFitnesses();
+}
+
+/**
+ * Orders slots from the best score to the worst.
+ */
+class BetterScore
+{
+public:
+	BetterScore(const vector<double> & in_scores) : scores(in_scores) {}
+	bool operator()(int g1, int g2) const
 	{
-		(*it)->setFitness((*it)->getScore());
+		if(HIGH_LOW == HIGH_IS_BEST)
+			return scores[g1] > scores[g2];
+		else
+			return scores[g1] < scores[g2];
 	}
-}
+private:
+	const vector<double> & scores;
+};
 
 void Population::rankScaling()
 {
-	noScaling(); // to make the fitness the same as the scores because we need to sort them
+	int num_genomes = (int)genome_scores.size();
 
-	int new_rank = (int)pop_genomes->size();
+	rank_order.resize(num_genomes);
+	for(int i = 0; i < num_genomes; ++i)
+		rank_order[i] = i;
+	std::sort(rank_order.begin(), rank_order.end(), BetterScore(genome_scores));
 
-	for(vector<Genome *>::iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
-	{
-		(*it)->setFitness(new_rank--);
-	}
+	genome_fitnesses.resize(num_genomes);
+	for(int rank = 0; rank < num_genomes; ++rank)
+		genome_fitnesses[rank_order[rank]] = num_genomes - rank;
+
+	scatterFitnesses();
 }
 
 void Population::diffScaling()
 {
+	int num_genomes = (int)genome_scores.size();
+	if(num_genomes == 0)
+		return;
+
+	double worst_score = genome_scores[getSummary().worst_index];
 	double difference;
-	for(vector<Genome *>::iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
+
+	genome_fitnesses.resize(num_genomes);
+	for(int i = 0; i < num_genomes; ++i)
 	{
-		difference = worst_genome->getScore() - (*it)->getScore();
+		difference = worst_score - genome_scores[i];
 		difference = (difference < 0) ? -1*difference : difference; // do not want negative fitness
-		(*it)->setFitness(difference);
+		genome_fitnesses[i] = difference;
 	}
+
+	scatterFitnesses();
 }
 
 Genome * Population::select()
@@ -255,53 +421,224 @@ Genome * Population::select()
 	}
 }
 
-Genome * Population::rankSelection()
+/**
+ * Orders slots from the highest fitness to the lowest.
+ */
+class HigherFitness
 {
-	rankScaling();
-	return rouletteWheelSelection();
-}
+public:
+	HigherFitness(const vector<double> & in_fitnesses) : fitnesses(in_fitnesses) {}
+	bool operator()(int g1, int g2) const
+	{
+		return fitnesses[g1] > fitnesses[g2];
+	}
+private:
+	const vector<double> & fitnesses;
+};
 
-Genome * Population::rouletteWheelSelection()
+void Population::buildSelectionWheel(bool by_rank)
 {
-	double slice_of_fitness = objRand->randomPercentage() * getTotalFitness();
-	double total = 0.0;
-	int selected_genome = 0;
+	int num_genomes = (int)genome_fitnesses.size();
+	selection_wheel.resize(num_genomes);
 
-	for(int i = 0; i < (int)pop_genomes->size(); ++i)
+	if(by_rank)
 	{
-		total += (*pop_genomes)[i]->getFitness();
+		// the fittest genome gets a slice of num_genomes, the least fit a slice of 1
+		rank_order.resize(num_genomes);
+		for(int i = 0; i < num_genomes; ++i)
+			rank_order[i] = i;
+		std::sort(rank_order.begin(), rank_order.end(), HigherFitness(genome_fitnesses));
+
+		for(int rank = 0; rank < num_genomes; ++rank)
+			selection_wheel[rank_order[rank]] = num_genomes - rank;
+	}
+	else
+	{
+		for(int i = 0; i < num_genomes; ++i)
+			selection_wheel[i] = genome_fitnesses[i];
+	}
 
-		if(total > slice_of_fitness)
-		{
-			selected_genome = i;
-			break;
-		}
+	// turn the slices into a running total
+	double total = 0.0;
+	for(int i = 0; i < num_genomes; ++i)
+	{
+		total += selection_wheel[i];
+		selection_wheel[i] = total;
 	}
 
-	return (*pop_genomes)[selected_genome];
+	selection_wheel_valid = true;
+	selection_wheel_by_rank = by_rank;
+}
+
+int Population::spinSelectionWheel(bool by_rank)
+{
+	if(!selection_wheel_valid || selection_wheel_by_rank != by_rank)
+		buildSelectionWheel(by_rank);
+
+	int num_genomes = (int)selection_wheel.size();
+	if(num_genomes == 0)
+		return -1;
+	double total = selection_wheel[num_genomes - 1];
+
+	// every genome has no fitness, so they all have the same chance
+	if(total <= 0.0)
+		return objRand->randomInt(num_genomes);
+
+	double slice_of_fitness = objRand->randomPercentage() * total;
+	int selected_genome = (int)(std::upper_bound(selection_wheel.begin(), selection_wheel.end(), slice_of_fitness)
+		- selection_wheel.begin());
+
+	return (selected_genome < num_genomes) ? selected_genome : num_genomes - 1;
+}
+
+Genome * Population::rankSelection()
+{
+	int selected = spinSelectionWheel(true);
+	return (selected >= 0) ? (*pop_genomes)[selected] : 0;
+}
+
+Genome * Population::rouletteWheelSelection()
+{
+	int selected = spinSelectionWheel(false);
+	return (selected >= 0) ? (*pop_genomes)[selected] : 0;
 }
 
 Genome * Population::tournamentSelection()
 {
-	double best_fitness = 0.0;
-	int the_choosen_one = 0;
+	int selected = playTournament();
+	return (selected >= 0) ? (*pop_genomes)[selected] : 0;
+}
+
+void Population::setTournamentSize(unsigned int size)
+{
+	tournament_size = size;
+}
+
+unsigned int Population::getTournamentSize() const
+{
+	return tournament_size;
+}
+
+int Population::playTournament()
+{
+	int num_genomes = (int)genome_fitnesses.size();
+	if(num_genomes == 0)
+		return -1;
 
 	// don't want to have more players than the size of the population.
-	// we want to have at most half the size of the population.
-	int num_players = (TOURNAMENT_SIZE > (int)pop_genomes->size()/2) ? (int)pop_genomes->size()/2 : TOURNAMENT_SIZE;
+	int num_players = ((int)tournament_size > num_genomes) ? num_genomes : (int)tournament_size;
+	if(num_players < 1)
+		num_players = 1;
 
-	for(int i = 0; i < num_players; ++i)
+	tournament_players.resize(num_genomes);
+	int the_choosen_one = -1;
+
+	if(2 * num_players <= num_genomes)
+	{
+		// few players, so just draw again if a genome has already been picked
+		for(int i = 0; i < num_players; ++i)
+		{
+			int random_index;
+			bool picked;
+			do
+			{
+				random_index = objRand->randomInt(num_genomes);
+				picked = false;
+				for(int j = 0; j < i; ++j)
+				{
+					if(tournament_players[j] == random_index)
+						picked = true;
+				}
+			} while(picked);
+
+			tournament_players[i] = random_index;
+			if(the_choosen_one == -1 || genome_fitnesses[random_index] > genome_fitnesses[the_choosen_one])
+				the_choosen_one = random_index;
+		}
+	}
+	else
 	{
-		int random_index = rand() % ((int)pop_genomes->size() - 1);
+		// most of the population is playing, so draw them with a partial shuffle
+		for(int i = 0; i < num_genomes; ++i)
+			tournament_players[i] = i;
 
-		if((*pop_genomes)[random_index]->getFitness() > best_fitness)
+		for(int i = 0; i < num_players; ++i)
 		{
-			the_choosen_one = random_index;
+			int j = i + objRand->randomInt(num_genomes - i);
+			int random_index = tournament_players[j];
+			tournament_players[j] = tournament_players[i];
+			tournament_players[i] = random_index;
+
+			if(the_choosen_one == -1 || genome_fitnesses[random_index] > genome_fitnesses[the_choosen_one])
+				the_choosen_one = random_index;
 		}
 	}
 
 	// return the winner
-	return (*pop_genomes)[the_choosen_one];
+	return the_choosen_one;
+}
+
+void Population::selectParents(unsigned int count, std::vector<int> & parents)
+{
+	// there is nothing to select from
+	if(pop_genomes->empty())
+	{
+		parents.clear();
+		return;
+	}
+
+	parents.resize(count);
+
+	if(SELECTION_SCHEME == TOURNAMENT)
+	{
+		for(unsigned int i = 0; i < count; ++i)
+			parents[i] = playTournament();
+		return;
+	}
+
+	sampleSelectionWheel(SELECTION_SCHEME == RANK_SELECTION, count, parents);
+
+	// the sample comes out in population order, shuffle it so mates are random
+	for(int i = (int)count - 1; i > 0; --i)
+	{
+		int j = objRand->randomInt(i + 1);
+		int tmp = parents[i];
+		parents[i] = parents[j];
+		parents[j] = tmp;
+	}
+}
+
+void Population::sampleSelectionWheel(bool by_rank, unsigned int count, std::vector<int> & selected)
+{
+	if(!selection_wheel_valid || selection_wheel_by_rank != by_rank)
+		buildSelectionWheel(by_rank);
+
+	int num_genomes = (int)selection_wheel.size();
+	if(num_genomes == 0)
+	{
+		selected.clear();
+		return;
+	}
+	double total = selection_wheel[num_genomes - 1];
+
+	// every genome has no fitness, so they all have the same chance
+	if(total <= 0.0)
+	{
+		for(unsigned int i = 0; i < count; ++i)
+			selected[i] = objRand->randomInt(num_genomes);
+		return;
+	}
+
+	// count pointers spaced total / count apart, starting at a random offset
+	double spacing = total / count;
+	double pointer = objRand->randomPercentage() * spacing;
+	int genome = 0;
+	for(unsigned int i = 0; i < count; ++i, pointer += spacing)
+	{
+		while(genome < num_genomes - 1 && selection_wheel[genome] <= pointer)
+			++genome;
+		selected[i] = genome;
+	}
 }
 
 vector<Genome *> * Population::getPopGenomes()
@@ -311,6 +648,9 @@ vector<Genome *> * Population::getPopGenomes()
 
 Population & Population::operator=(const Population & other)
 {
+	if(this == &other)
+		return *this;
+
 	for(vector<Genome *>::iterator it = pop_genomes->begin();
 		it != pop_genomes->end();
 		++it)
@@ -318,16 +658,12 @@ Population & Population::operator=(const Population & other)
 		delete *it;
 	}
 	delete pop_genomes;
-	delete objRand;
-
-
-	best_genome = other.best_genome->clone();
-	worst_genome = other.worst_genome->clone();
 
 	population_size = other.population_size;
-	objRand = new Random(*objRand);
+	tournament_size = other.tournament_size;
 
 	pop_genomes = new vector<Genome *>;
+	selection_wheel_valid = false;
 
 	for(vector<Genome *>::iterator it = other.pop_genomes->begin();
 		it != other.pop_genomes->end();
@@ -336,19 +672,28 @@ Population & Population::operator=(const Population & other)
 		pop_genomes->push_back((*it)->clone());
 	}
 
+	// the best and worst genomes have to point into this population, not the other one
+	gatherGenomeValues();
+	updateBestWorst();
+
 	return *this;
 }
 
 ostream & operator<<(std::ostream & os, const Population & pop)
 {
-	os << "Total Score: " << pop.getTotalScore() << endl;
-	os << "Total Fitness: " << pop.getTotalFitness() << endl;
-	os << "Average Score: " << pop.getAveScore() << endl;
-	os << "Average Fitness: " << pop.getAveFitness() << endl;
-	os << ">> Best Genome <<" << endl;
-	os << pop.getBestGenome() << endl;
-	os << ">> Worst Genome <<" << endl;
-	os << pop.getWorstGenome() << endl;
+	const PopulationSummary & summary = pop.getSummary();
+
+	os << "Total Score: " << summary.total_score << endl;
+	os << "Total Fitness: " << summary.total_fitness << endl;
+	os << "Average Score: " << summary.ave_score << endl;
+	os << "Average Fitness: " << summary.ave_fitness << endl;
+	if(summary.best_index >= 0)
+	{
+		os << ">> Best Genome <<" << endl;
+		os << pop.getBestGenome() << endl;
+		os << ">> Worst Genome <<" << endl;
+		os << pop.getWorstGenome() << endl;
+	}
 
 	return os;
 }
@@ -362,39 +707,89 @@ void Population::setPopGenomes(std::vector<Genome *> *new_pop)
 	{
 		delete (*it);
 	}
-	getPopGenomes()->clear();
+	delete pop_genomes;
 
 	pop_genomes = new_pop;
+	selection_wheel_valid = false;
+	gatherGenomeValues();
+}
+
+void Population::swapPopGenomes(std::vector<Genome *> & genomes)
+{
+	pop_genomes->swap(genomes);
+	selection_wheel_valid = false;
+	gatherGenomeValues();
+}
+
+GenomePool & Population::getGenomePool()
+{
+	return genome_pool;
 }
 
 void Population::updateBestWorst()
 {
-	best_genome = (*pop_genomes)[0]; 
-	worst_genome = (*pop_genomes)[0];
+	summary_valid = false;
+	getSummary();
+}
 
-	for(vector<Genome *>::iterator it = pop_genomes->begin();
-		it != pop_genomes->end();
-		++it)
+/**
+ * Orders genomes by score or fitness for the sorting functions.
+ * Largest first is what the population calls ascending order (ascending rank).
+ */
+class GenomeOrder
+{
+public:
+	GenomeOrder(bool in_by_fitness, bool in_largest_first)
+		: by_fitness(in_by_fitness), largest_first(in_largest_first) {}
+	bool operator()(const Genome *g1, const Genome *g2) const
 	{
-		if(HIGH_LOW == HIGH_IS_BEST)
-		{
-			if(best_genome->getScore() < (*it)->getScore())
-				best_genome = (*it);
-			if(worst_genome->getScore() > (*it)->getScore())
-				worst_genome = (*it);
-		}
-		else
+		double v1 = by_fitness ? g1->getFitness() : g1->getScore();
+		double v2 = by_fitness ? g2->getFitness() : g2->getScore();
+		return largest_first ? v1 > v2 : v1 < v2;
+	}
+private:
+	bool by_fitness;
+	bool largest_first;
+};
+
+void Population::replaceWorst(std::vector<Genome *> & genomes)
+{
+	size_t num_replaced = genomes.size();
+	if(num_replaced > pop_genomes->size())
+		num_replaced = pop_genomes->size();
+
+	if(num_replaced > 0)
+	{
+		// move the worst genomes to the back, best scores first
+		vector<Genome *>::iterator worst = pop_genomes->end() - num_replaced;
+		std::nth_element(pop_genomes->begin(), worst, pop_genomes->end(),
+			GenomeOrder(false, HIGH_LOW == HIGH_IS_BEST));
+
+		for(size_t i = 0; i < num_replaced; ++i, ++worst)
 		{
-			if(best_genome->getScore() > (*it)->getScore())
-				best_genome = (*it);
-			if(worst_genome->getScore() < (*it)->getScore())
-				worst_genome = (*it);
+			// migrants made with clone() would otherwise pile up in the pool
+			if(genome_pool.getNumFree() < pop_genomes->size())
+				genome_pool.release(*worst);
+			else
+				delete *worst;
+			*worst = genomes[i];
 		}
-	}	
+
+		selection_wheel_valid = false;
+		gatherGenomeValues();
+	}
+
+	// any the population had no room for are not kept
+	for(size_t i = num_replaced; i < genomes.size(); ++i)
+		delete genomes[i];
+	genomes.clear();
 }
 
 void Population::sortPopulation()
 {
+	// the genomes are about to move, so the wheel will not match them anymore
+	selection_wheel_valid = false;
+
 	if(SORT_ORDER == ASC)
 	{
 		if(SORT_TYPE == SCORE)
@@ -405,110 +800,62 @@ void Population::sortPopulation()
 	else
 	{
 		// DESC
-		if(SORT_TYPE == FITNESS)
+		if(SORT_TYPE == SCORE)
 			Population::SortDescendingScores(pop_genomes, 0, (int)(pop_genomes->size() -1));
 		else
 			Population::SortDescendingFitness(pop_genomes, 0, (int)(pop_genomes->size() -1));
 	}
+
+	// the genomes have moved to new slots
+	gatherGenomeValues();
+	updateBestWorst();
 }
 
+void Population::sortElite(unsigned int num_elite)
+{
+	if(num_elite >= pop_genomes->size())
+	{
+		sortPopulation();
+		return;
+	}
+	if(num_elite == 0)
+		return;
+
+	// the genomes are about to move, so the wheel will not match them anymore
+	selection_wheel_valid = false;
+
+	GenomeOrder order(SORT_TYPE == FITNESS, SORT_ORDER == ASC);
+	vector<Genome *>::iterator elite_end = pop_genomes->begin() + num_elite;
+
+	// introselect puts the elite in front, then only the elite itself is sorted
+	std::nth_element(pop_genomes->begin(), elite_end, pop_genomes->end(), order);
+	std::sort(pop_genomes->begin(), elite_end, order);
+
+	// the genomes have moved to new slots
+	gatherGenomeValues();
+	updateBestWorst();
+}
 
 void Population::SortDescendingScores(vector<Genome *> *g, int l, int r) 
 {
-	int i,j; 
-	double v; 
-	Genome *tmp;
 	if(r > l)
-	{
-		v = (*g)[r]->getScore(); i = l-1; j = r;
-		for(;;)
-		{
-			while((*g)[++i]->getScore() < v && i <= r);
-			while((*g)[--j]->getScore() > v && j > 0);
-			if(i >= j) break;
-			tmp = (*g)[i]; 
-			(*g)[i] = (*g)[j]; 
-			(*g)[j] = tmp;
-		}
-		tmp = (*g)[i]; 
-		(*g)[i] = (*g)[r]; 
-		(*g)[r] = tmp;
-		Population::SortDescendingScores(g,l,i-1);
-		Population::SortDescendingScores(g,i+1,r);
-	}
+		std::sort(g->begin() + l, g->begin() + r + 1, GenomeOrder(false, false));
 }
 
 void Population::SortDescendingFitness(std::vector<Genome *> *g, int l, int r)
 {
-	int i,j; 
-	double v; 
-	Genome *tmp;
 	if(r > l)
-	{
-		v = (*g)[r]->getFitness(); i = l-1; j = r;
-		for(;;)
-		{
-			while((*g)[++i]->getFitness() < v && i <= r);
-			while((*g)[--j]->getFitness() > v && j > 0);
-			if(i >= j) break;
-			tmp = (*g)[i]; 
-			(*g)[i] = (*g)[j]; 
-			(*g)[j] = tmp;
-		}
-		tmp = (*g)[i]; 
-		(*g)[i] = (*g)[r]; 
-		(*g)[r] = tmp;
-		Population::SortDescendingScores(g,l,i-1);
-		Population::SortDescendingScores(g,i+1,r);
-	}
+		std::sort(g->begin() + l, g->begin() + r + 1, GenomeOrder(true, false));
 }
 
 void Population::SortAscendingScores(vector<Genome *> *g, int l, int r) 
 {
-	int i,j; 
-	double v; 
-	Genome *tmp;
 	if(r > l)
-	{
-		v = (*g)[r]->getScore(); i = l-1; j = r;
-		for(;;)
-		{
-			while((*g)[++i]->getScore() > v && i <= r);
-			while((*g)[--j]->getScore() < v && j > 0);
-			if(i >= j) break;
-			tmp = (*g)[i]; 
-			(*g)[i] = (*g)[j]; 
-			(*g)[j] = tmp;
-		}
-		tmp = (*g)[i]; 
-		(*g)[i] = (*g)[r]; 
-		(*g)[r] = tmp;
-		Population::SortDescendingScores(g,l,i-1);
-		Population::SortDescendingScores(g,i+1,r);
-	}
+		std::sort(g->begin() + l, g->begin() + r + 1, GenomeOrder(false, true));
 }
 
 void Population::SortAscendingFitness(std::vector<Genome *> *g, int l, int r)
 {
-	int i,j; 
-	double v; 
-	Genome *tmp;
 	if(r > l)
-	{
-		v = (*g)[r]->getFitness(); i = l-1; j = r;
-		for(;;)
-		{
-			while((*g)[++i]->getFitness() > v && i <= r);
-			while((*g)[--j]->getFitness() < v && j > 0);
-			if(i >= j) break;
-			tmp = (*g)[i]; 
-			(*g)[i] = (*g)[j]; 
-			(*g)[j] = tmp;
-		}
-		tmp = (*g)[i]; 
-		(*g)[i] = (*g)[r]; 
-		(*g)[r] = tmp;
-		Population::SortDescendingScores(g,l,i-1);
-		Population::SortDescendingScores(g,i+1,r);
-	}
+		std::sort(g->begin() + l, g->begin() + r + 1, GenomeOrder(true, true));
 }
\ No newline at end of file
@@ -10,8 +10,53 @@
 #include "config.h"
 class Genome;
 class Random;
+class ThreadPool;
 
 #include <vector>
+#include "GenomePool.h"
+
+/**
+ * A summary of the scores and fitnesses of a population, worked out in one pass.
+ */
+struct PopulationSummary
+{
+	/**
+	 * The total score of the population.
+	 */
+	double total_score;
+	/**
+	 * The total fitness of the population.
+	 */
+	double total_fitness;
+	/**
+	 * The average score of the population.
+	 */
+	double ave_score;
+	/**
+	 * The average fitness of the population.
+	 */
+	double ave_fitness;
+	/**
+	 * The lowest score in the population.
+	 */
+	double min_score;
+	/**
+	 * The highest score in the population.
+	 */
+	double max_score;
+	/**
+	 * The variance of the scores in the population.
+	 */
+	double score_variance;
+	/**
+	 * The slot of the best genome, -1 if the population is empty.
+	 */
+	int best_index;
+	/**
+	 * The slot of the worst genome, -1 if the population is empty.
+	 */
+	int worst_index;
+};
 
 /**
  * This class is a container for the genomes. Its a population of genomes
@@ -77,14 +122,73 @@ public:
 	 */
 	double getAveFitness() const;
 
+	/**
+	 * Gets the summary of the population. It is worked out in a single pass over the
+	 * score and fitness arrays the first time it is asked for, and then kept until the
+	 * scores or fitnesses change.
+	 * \return a reference to the summary.
+	 */
+	const PopulationSummary & getSummary() const;
+
+	/**
+	 * Gets the score of the genome in a slot, from the population's score array.
+	 * \param slot is the slot of the genome.
+	 * \return the score of that genome.
+	 */
+	double getScore(unsigned int slot) const;
+	/**
+	 * Gets the fitness of the genome in a slot, from the population's fitness array.
+	 * \param slot is the slot of the genome.
+	 * \return the fitness of that genome.
+	 */
+	double getFitness(unsigned int slot) const;
+
 	/**
 	 * Sorts the population.
 	 */
 	void sortPopulation();
 	/**
-	 * Calculates all the population scores.
+	 * Puts the best num_elite genomes, in sorted order, at the front of the population.
+	 * The order of the rest is left unspecified. This costs a linear partition plus
+	 * sorting the elite only, instead of sorting the whole population.
+	 * \param num_elite is the number of genomes wanted at the front.
+	 */
+	void sortElite(unsigned int num_elite);
+	/**
+	 * Calculates the population scores. Only the genomes that are not already
+	 * evaluated are evaluated.
 	 */
 	void evaluatePopulationScores();
+	/**
+	 * Sets the number of threads used to evaluate the population. With more than one
+	 * thread the genomes that need evaluating are split over a pool of workers that is
+	 * kept for the life of the population. The scores are the same as with one thread.
+	 * \param num_threads is the number of threads. It defaults to EVALUATION_THREADS.
+	 */
+	void setEvaluationThreads(unsigned int num_threads);
+	/**
+	 * Gets the number of threads used to evaluate the population.
+	 * \return the number of threads.
+	 */
+	unsigned int getEvaluationThreads() const;
+	/**
+	 * Gets the number of genome evaluations this population has done.
+	 * \return the number of evaluations.
+	 */
+	unsigned long getEvaluationCount() const;
+	/**
+	 * Measures the diversity of the population as the average Genome::distance() from the
+	 * best genome to genomes spread evenly over the population. It does not draw random
+	 * numbers, so it does not change the run.
+	 * \param samples is the number of genomes compared with the best. It defaults to DIVERSITY_SAMPLES.
+	 * \return the diversity, from 0 when every genome sampled is the same as the best up to 1.
+	 */
+	double getDiversity(unsigned int samples = DIVERSITY_SAMPLES) const;
+	/**
+	 * Seeds the random number generator used for selection, so a run can be repeated.
+	 * \param seed is the seed.
+	 */
+	void setSeed(unsigned long long seed);
 	/**
 	 * Calculates all the population fitnesses.
 	 */
@@ -102,11 +206,13 @@ public:
 	Genome * getGenome(unsigned int index);
 	/**
 	 * Gets the best genome in the population.
+	 * \pre the population is not empty.
 	 * \return a reference to the best genome in the population.
 	 */
 	Genome & getBestGenome() const;
 	/**
 	 * Gets the worst genome in the population.
+	 * \pre the population is not empty.
 	 * \return a reference to the worst genome in the population.
 	 */
 	Genome & getWorstGenome() const;
@@ -137,7 +243,8 @@ public:
 	 */
 	void noScaling();
 	/**
-	 * Rank scaling will occur.
+	 * Rank scaling will occur. The best genome gets a fitness of the population size
+	 * and the worst a fitness of 1.
 	 */
 	void rankScaling();
 	/**
@@ -150,6 +257,27 @@ public:
 	 * \param new_pop is a pointer to a vector of genomes.
 	 */
 	void setPopGenomes(std::vector<Genome *> *new_pop);
+	/**
+	 * Replaces the genomes with the worst scores by the given genomes, which the population
+	 * then owns. The replaced genomes go to the genome pool, or are deleted once the pool
+	 * holds as many genomes as the population, so genomes made outside the pool do not
+	 * make it grow. The population needs to be initialized again before its fitnesses are used.
+	 * \param genomes are the genomes to put in. The vector is emptied.
+	 */
+	void replaceWorst(std::vector<Genome *> & genomes);
+	/**
+	 * Swaps the genomes of the population with the given ones. Neither the genomes nor
+	 * the vectors are copied, so this does not allocate.
+	 * \param genomes are the genomes of the next population. They get the old genomes,
+	 * which the caller then owns.
+	 */
+	void swapPopGenomes(std::vector<Genome *> & genomes);
+	/**
+	 * Gets the pool that genomes leaving this population go to, so they can be reused
+	 * for the next generation.
+	 * \return a reference to the pool.
+	 */
+	GenomePool & getGenomePool();
 	/**
 	 * This will returna  pointer to the vector of genomes.
 	 * \return the vector of genomes of the population.
@@ -161,52 +289,86 @@ public:
 	 * \return a pointer to the selected genome.
 	 */
 	Genome * select();
+	/**
+	 * Selects all the parents needed for a generation in one call. Roulette wheel and rank
+	 * selection use stochastic universal sampling: one random number and one sweep of the
+	 * selection wheel. The parents are then shuffled so that pairs taken in order are not
+	 * neighbours on the wheel. Tournament selection plays one tournament per parent.
+	 * \param count is the number of parents to select.
+	 * \param parents is filled with the indexes of the selected genomes. It is left empty
+	 * if the population is.
+	 */
+	void selectParents(unsigned int count, std::vector<int> & parents);
+
+	/**
+	 * Builds the selection wheel for this generation. This is the running total of
+	 * the fitnesses (or of the ranks for rank selection), so each selection is a binary
+	 * search instead of a pass over the population. It is called after scaling and
+	 * rebuilt by select() whenever the population has changed since.
+	 * \param by_rank is true to give each genome a slice by its rank instead of its fitness.
+	 */
+	void buildSelectionWheel(bool by_rank);
 	/**
 	 * Rank selection will occur.
-	 * \return a pointer to the selected genome.
+	 * \return a pointer to the selected genome, 0 if the population is empty.
 	 */
 	Genome * rankSelection();
 	/**
 	 * Roulette wheel selection will occur.
-	 * \return a pointer to the selected genome.
+	 * \return a pointer to the selected genome, 0 if the population is empty.
 	 */
 	Genome * rouletteWheelSelection();
 	/**
-	 * Tournament selection will occur.
-	 * \return a pointer to the selected genome.
+	 * Tournament selection will occur. tournament_size different genomes are picked at
+	 * random and the fittest of them wins.
+	 * \return a pointer to the selected genome, 0 if the population is empty.
 	 */
 	Genome * tournamentSelection();
+	/**
+	 * Sets the number of genomes that play in each tournament.
+	 * \param size is the arity of the tournament. It defaults to TOURNAMENT_SIZE.
+	 */
+	void setTournamentSize(unsigned int size);
+	/**
+	 * Gets the number of genomes that play in each tournament.
+	 * \return the arity of the tournament.
+	 */
+	unsigned int getTournamentSize() const;
 
 	/**
 	 * Static function to sort the genomes in Decending order by their scores.
-	 * This is a quicksort sorting algorithm.
+	 * The genome with the lowest score comes first. This is an introsort, so it stays
+	 * O(n log n) even when most of the values are equal.
 	 * \param g is the genomes to be sorted
-	 * \param l is the left side of the quicksort algorithm
-	 * \param r is the right side of the quicksort algorithm
+	 * \param l is the first index of the range to sort
+	 * \param r is the last index of the range to sort
 	 */
 	static void SortDescendingScores(std::vector<Genome *> *g, int l, int r);
 	/**
 	 * Static function to sort the genomes in Decending order by their fitnesses.
-	 * This is a quicksort sorting algorithm.
+	 * The genome with the lowest fitness comes first. This is an introsort, so it stays
+	 * O(n log n) even when most of the values are equal.
 	 * \param g is the genomes to be sorted
-	 * \param l is the left side of the quicksort algorithm
-	 * \param r is the right side of the quicksort algorithm
+	 * \param l is the first index of the range to sort
+	 * \param r is the last index of the range to sort
 	 */
 	static void SortDescendingFitness(std::vector<Genome *> *g, int l, int r);
 	/**
 	 * Static function to sort the genomes in Ascending order by their scores.
-	 * This is a quicksort sorting algorithm.
+	 * The genome with the highest score comes first. This is an introsort, so it stays
+	 * O(n log n) even when most of the values are equal.
 	 * \param g is the genomes to be sorted
-	 * \param l is the left side of the quicksort algorithm
-	 * \param r is the right side of the quicksort algorithm
+	 * \param l is the first index of the range to sort
+	 * \param r is the last index of the range to sort
 	 */
 	static void SortAscendingScores(std::vector<Genome *> *g, int l, int r);
 	/**
 	 * Static function to sort the genomes in Ascending order by their fitnesses.
-	 * This is a quicksort sorting algorithm.
+	 * The genome with the highest fitness comes first. This is an introsort, so it stays
+	 * O(n log n) even when most of the values are equal.
 	 * \param g is the genomes to be sorted
-	 * \param l is the left side of the quicksort algorithm
-	 * \param r is the right side of the quicksort algorithm
+	 * \param l is the first index of the range to sort
+	 * \param r is the last index of the range to sort
 	 */
 	static void SortAscendingFitness(std::vector<Genome *> *g, int l, int r);
 
@@ -224,7 +386,7 @@ public:
 	 */
 	Population & operator=(const Population & other);
 	/**
-	 * Update the best and wort genomes in the population.
+	 * Update the best and wort genomes in the population. This works out the summary again.
 	 */
 	void updateBestWorst();
 
@@ -234,23 +396,105 @@ private:
 	 */
 	std::vector<Genome *> *pop_genomes;
 	/**
-	 * A pointer to the best genome in the population.
+	 * The genomes that have left the population, kept to be used again.
+	 */
+	GenomePool genome_pool;
+	/**
+	 * The summary of the scores and fitnesses, including the best and worst genomes.
 	 */
-	Genome * best_genome;
+	mutable PopulationSummary summary;
 	/**
-	 * A pointer to the worst genome in the population.
+	 * True when the summary matches the scores and fitnesses.
 	 */
-	Genome * worst_genome;
+	mutable bool summary_valid;
+
+	/**
+	 * The scores of the genomes, indexed by slot. The aggregates, scaling and selection
+	 * all stream over this array instead of going through the genome pointers.
+	 */
+	std::vector<double> genome_scores;
+	/**
+	 * The fitnesses of the genomes, indexed by slot.
+	 */
+	std::vector<double> genome_fitnesses;
 
 	/**
 	 * The size of the population.
 	 */
 	unsigned int population_size;
+	/**
+	 * The number of genome evaluations done so far.
+	 */
+	unsigned long evaluation_count;
+	/**
+	 * The workers used to evaluate the population, 0 when it is evaluated on one thread.
+	 */
+	ThreadPool *evaluation_pool;
+	/**
+	 * The genomes that need evaluating. Kept so evaluation does not allocate.
+	 */
+	std::vector<Genome *> dirty_genomes;
 
 	/**
 	 * A pointer to a random object.
 	 */
 	Random *objRand;
+
+	/**
+	 * Gives every genome its slot and copies their scores and fitnesses into the arrays.
+	 * This is needed whenever the genomes have been replaced or moved.
+	 */
+	void gatherGenomeValues();
+	/**
+	 * Copies the fitness array back into the genomes after scaling.
+	 */
+	void scatterFitnesses();
+
+	/**
+	 * Spins the selection wheel, building it first if it is out of date.
+	 * \param by_rank is true to spin the rank selection wheel.
+	 * \return the index of the selected genome, -1 if the population is empty.
+	 */
+	int spinSelectionWheel(bool by_rank);
+	/**
+	 * Spins the selection wheel with count equally spaced pointers (stochastic universal sampling).
+	 * \param by_rank is true to use the rank selection wheel.
+	 * \param count is the number of genomes to select.
+	 * \param selected is filled with the indexes of the selected genomes, in population order.
+	 * It is left empty if the population is.
+	 */
+	void sampleSelectionWheel(bool by_rank, unsigned int count, std::vector<int> & selected);
+	/**
+	 * Plays one tournament.
+	 * \return the index of the winner, -1 if the population is empty.
+	 */
+	int playTournament();
+
+	/**
+	 * The running total of the fitnesses (or ranks) of the genomes, in population order.
+	 */
+	std::vector<double> selection_wheel;
+	/**
+	 * The genome indexes ordered by fitness or score. Scratch space for ranking.
+	 */
+	std::vector<int> rank_order;
+	/**
+	 * True when the selection wheel matches the current genomes and fitnesses.
+	 */
+	bool selection_wheel_valid;
+	/**
+	 * True when the selection wheel was built from the ranks.
+	 */
+	bool selection_wheel_by_rank;
+
+	/**
+	 * The number of genomes that play in each tournament.
+	 */
+	unsigned int tournament_size;
+	/**
+	 * The players of the current tournament. Kept so tournaments do not allocate.
+	 */
+	std::vector<int> tournament_players;
 };
 
 #endif
\ No newline at end of file
@@ -1,14 +1,40 @@
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
+#include <chrono>
+#include <random>
+#include <atomic>
 
 using namespace std;
 
 #include "Random.h"
 
+// counts the objects seeded from the system so two made at once still differ
+static atomic<unsigned long long> seed_count(0);
+
+static inline unsigned long long rotl(unsigned long long x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+// one step of SplitMix64, used to spread a seed over the whole state
+static inline unsigned long long splitMix64(unsigned long long & x)
+{
+	unsigned long long z = (x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
 Random::Random()
 {
-	srand((unsigned int)time(NULL));
+	random_device device;
+	unsigned long long system_seed = ((unsigned long long)device() << 32) ^ device();
+	system_seed ^= (unsigned long long)chrono::high_resolution_clock::now().time_since_epoch().count();
+	seed(system_seed + 0x9E3779B97F4A7C15ULL * ++seed_count);
+}
+
+Random::Random(unsigned long long seed_value)
+{
+	seed(seed_value);
 }
 
 Random::~Random()
@@ -16,18 +42,93 @@ Random::~Random()
 
 }
 
+void Random::seed(unsigned long long seed_value)
+{
+	// SplitMix64 never gives four zeros in a row, so the state is always valid
+	for(int i = 0; i < 4; ++i)
+		state[i] = splitMix64(seed_value);
+}
+
+void Random::seed(unsigned long long key, unsigned long long stream, unsigned long long counter)
+{
+	// hash the position into the key one word at a time, each step mixes every bit
+	unsigned long long hash = splitMix64(key) ^ stream;
+	hash = splitMix64(hash) ^ counter;
+	seed(hash);
+}
+
+unsigned long long Random::randomBits()
+{
+	const unsigned long long result = rotl(state[1] * 5, 7) * 9;
+	const unsigned long long t = state[1] << 17;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+
+	state[2] ^= t;
+	state[3] = rotl(state[3], 45);
+
+	return result;
+}
+
 int Random::randomInt(int max)
 {
-	return rand() % max;
-	
+	// multiply the top 32 bits by max and keep the high half, throwing away the few
+	// values that would make the low results more likely than the high ones
+	unsigned long long range = (unsigned int)max;
+	unsigned long long product = (randomBits() >> 32) * range;
+	unsigned int low = (unsigned int)product;
+	if(low < range)
+	{
+		unsigned int threshold = (unsigned int)(-(unsigned int)range) % (unsigned int)range;
+		while(low < threshold)
+		{
+			product = (randomBits() >> 32) * range;
+			low = (unsigned int)product;
+		}
+	}
+	return (int)(product >> 32);
 }
 
 double Random::randomDouble(int max)
 {
-	return (rand() % (max*1000)) / 1000.0;
+	return randomPercentage() * max;
 }
 
 double Random::randomPercentage()
 {
-	return (rand() % 10000) / 10000.0;
-}
\ No newline at end of file
+	// the top 53 bits fill the mantissa exactly
+	return (randomBits() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void Random::jump()
+{
+	static const unsigned long long JUMP[4] =
+		{ 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+
+	unsigned long long s[4] = { 0, 0, 0, 0 };
+	for(int i = 0; i < 4; ++i)
+	{
+		for(int b = 0; b < 64; ++b)
+		{
+			if(JUMP[i] & (1ULL << b))
+			{
+				for(int j = 0; j < 4; ++j)
+					s[j] ^= state[j];
+			}
+			randomBits();
+		}
+	}
+
+	for(int j = 0; j < 4; ++j)
+		state[j] = s[j];
+}
+
+Random Random::split()
+{
+	Random stream(*this);
+	jump();
+	return stream;
+}
@@ -8,36 +8,81 @@
 
 /**
  * This class is used to generate some random numbers.
+ * It is a xoshiro256** generator. Every Random object has its own state, so each
+ * thread can draw from its own object without locking. split() hands out streams
+ * that are far enough apart in the sequence that they never overlap.
  */
 class Random
 {
 public:
 	/**
-	 * Default constructor
+	 * Default constructor. The state is seeded from the system, so every object
+	 * gives different numbers. Use the overloaded constructor or seed() to repeat a run.
 	 */
 	Random();
+	/**
+	 * Overloaded constructor.
+	 * \param seed is the seed of the state. The same seed gives the same numbers.
+	 */
+	Random(unsigned long long seed);
 	/**
 	 * Destructor
 	 */
 	~Random();
 
 	/**
-	 * Gets a random integer from 0 to max.
-	 * \param max is the maximum integer it can return.
-	 * \return an integer from 0 to max
+	 * Seeds the state again. Any seed, including 0, is fine.
+	 * \param seed is the new seed.
+	 */
+	void seed(unsigned long long seed);
+	/**
+	 * Seeds the state from a key and a position, so the numbers depend only on those and
+	 * not on what was drawn before. Different positions give unrelated streams.
+	 * \param key is the seed of the run.
+	 * \param stream is the first part of the position, for example the generation.
+	 * \param counter is the second part of the position, for example the child.
+	 */
+	void seed(unsigned long long key, unsigned long long stream, unsigned long long counter);
+
+	/**
+	 * Gets 64 random bits.
+	 * \return the next number in the sequence.
+	 */
+	unsigned long long randomBits();
+	/**
+	 * Gets a random integer from 0 to max - 1. Every value is equally likely.
+	 * \param max is one more than the maximum integer it can return. It must be positive.
+	 * \return an integer from 0 to max - 1
 	 */
-	static int randomInt(int max);
+	int randomInt(int max);
 	/**
-	 * Gets a random double from 0 to max.
+	 * Gets a random double from 0 up to (not including) max.
 	 * \param max is the maximum double it can return.
 	 * \return an double from 0 to max
 	 */
-	static double randomDouble(int max);
+	double randomDouble(int max);
+	/**
+	 * Gets a random percentage with the full 53 bits of precision of a double.
+	 * \return a percentage, from 0 up to (not including) 1.
+	 */
+	double randomPercentage();
+
+	/**
+	 * Advances the state by 2^128 numbers, as if randomBits() had been called that many times.
+	 */
+	void jump();
+	/**
+	 * Hands out an independent stream. The stream starts where this generator is now,
+	 * then this generator jumps ahead, so the two never overlap.
+	 * \return the new stream.
+	 */
+	Random split();
+
+private:
 	/**
-	 * Gets a random percentage
-	 * \return a percentage, from 0 to 1.
+	 * The state of the generator. It is never all zero.
 	 */
-	static double randomPercentage();
+	unsigned long long state[4];
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <chrono>
+
+#include "Reporter.h"
+
+using namespace std;
+
+// how long the writer thread sleeps when the queue is empty
+static const int WRITER_POLL_MS = 10;
+
+Reporter::Reporter(ostream & in_os, unsigned int queue_size)
+	: os(in_os), tail(0), head(0), written(0), dropped(0),
+	  every_generations(REPORT_GENERATIONS), every_milliseconds(REPORT_INTERVAL_MS), last_report_time(0.0),
+	  silent(false), stopping(false)
+{
+	// a power of 2 lets a position be turned into an index with a mask
+	unsigned int size = 1;
+	while(size < queue_size)
+		size <<= 1;
+	queue.resize(size);
+
+	writer = thread(&Reporter::writerLoop, this);
+}
+
+Reporter::~Reporter()
+{
+	{
+		lock_guard<mutex> lock(writer_mutex);
+		stopping = true;
+	}
+	writer_wake.notify_one();
+	writer.join();
+}
+
+void Reporter::setInterval(unsigned int generations, unsigned int milliseconds)
+{
+	every_generations = generations;
+	every_milliseconds = milliseconds;
+}
+
+void Reporter::setSilent(bool in_silent)
+{
+	silent.store(in_silent, memory_order_relaxed);
+}
+
+bool Reporter::isSilent() const
+{
+	return silent.load(memory_order_relaxed);
+}
+
+bool Reporter::isDue(const GenerationMetrics & metrics)
+{
+	if(every_generations == 0 && every_milliseconds == 0)
+		return true;
+
+	if(every_generations > 0 && metrics.generation % every_generations == 0)
+		return true;
+
+	// a wall time before the last report means a new run has started
+	if(every_milliseconds > 0 &&
+		(metrics.wall_time < last_report_time ||
+		(metrics.wall_time - last_report_time) * 1000.0 >= every_milliseconds))
+		return true;
+
+	return false;
+}
+
+bool Reporter::publish(const GenerationMetrics & metrics)
+{
+	if(isSilent() || !isDue(metrics))
+		return false;
+	last_report_time = metrics.wall_time;
+
+	unsigned long long pos = tail.load(memory_order_relaxed);
+	if(pos - head.load(memory_order_acquire) >= queue.size())
+	{
+		dropped.fetch_add(1, memory_order_relaxed);
+		return false;
+	}
+
+	queue[pos & (queue.size() - 1)] = metrics;
+	tail.store(pos + 1, memory_order_release);
+	return true;
+}
+
+void Reporter::flush()
+{
+	unique_lock<mutex> lock(writer_mutex);
+	unsigned long long target = tail.load(memory_order_acquire);
+	writer_wake.notify_one();
+	while(written.load(memory_order_acquire) < target)
+		writer_done.wait(lock);
+}
+
+unsigned long long Reporter::getNumDropped() const
+{
+	return dropped.load(memory_order_relaxed);
+}
+
+void Reporter::writerLoop()
+{
+	for(;;)
+	{
+		bool stop;
+		{
+			unique_lock<mutex> lock(writer_mutex);
+			if(!stopping && head.load(memory_order_relaxed) == tail.load(memory_order_acquire))
+				writer_wake.wait_for(lock, chrono::milliseconds(WRITER_POLL_MS));
+			stop = stopping;
+		}
+
+		writeQueued();
+
+		{
+			lock_guard<mutex> lock(writer_mutex);
+			writer_done.notify_all();
+		}
+
+		// the last generations were written out above
+		if(stop)
+			return;
+	}
+}
+
+bool Reporter::writeQueued()
+{
+	unsigned long long pos = head.load(memory_order_relaxed);
+	unsigned long long end = tail.load(memory_order_acquire);
+	if(pos == end)
+		return false;
+
+	for(; pos != end; ++pos)
+	{
+		// copy the generation out so its slot can be reused while it is formatted
+		GenerationMetrics metrics = queue[pos & (queue.size() - 1)];
+		head.store(pos + 1, memory_order_release);
+
+		os << "Generation " << metrics.generation
+			<< ": best " << metrics.best_score
+			<< ", mean " << metrics.mean_score
+			<< ", worst " << metrics.worst_score
+			<< ", stddev " << metrics.score_stddev
+			<< ", diversity " << metrics.diversity
+			<< ", evaluations " << metrics.evaluations
+			<< ", " << metrics.wall_time << "s\n";
+	}
+	os.flush();
+
+	written.store(end, memory_order_release);
+	return true;
+}
@@ -0,0 +1,165 @@
+#ifndef REPORTER_H
+#define REPORTER_H
+
+/**
+ * \file Reporter.h
+ */
+
+#include <vector>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "config.h"
+#include "MetricHistory.h"
+
+/**
+ * This class writes out the progress of a genetic algorithm from a thread of its own, so
+ * the evolution loop never waits on the output stream. The loop publishes the metrics of
+ * each generation into a fixed size queue without taking a lock, and the writer thread
+ * takes them out and formats them. Only every so many generations, or every so many
+ * milliseconds, is published; a generation that finds the queue full is dropped.
+ * \note A reporter is fed by one genetic algorithm at a time.
+ */
+class Reporter
+{
+public:
+	/**
+	 * Overloaded constructor. Starts the writer thread.
+	 * \param in_os is the stream to write to. It must outlive the reporter.
+	 * \param queue_size is the number of generations that can wait to be written.
+	 */
+	Reporter(std::ostream & in_os = std::cout, unsigned int queue_size = REPORT_QUEUE_SIZE);
+	/**
+	 * Destructor. Writes out what is left in the queue and joins the writer thread.
+	 */
+	~Reporter();
+
+	/**
+	 * Sets how often a generation is reported.
+	 * \param generations reports every generation that is a multiple of it, 0 for none.
+	 * \param milliseconds also reports a generation if this long has passed since the last one, 0 for none.
+	 * \note If both are 0 every generation is reported.
+	 */
+	void setInterval(unsigned int generations, unsigned int milliseconds = 0);
+	/**
+	 * Sets if the reporter is silent. A silent reporter ignores everything published to it.
+	 * \param in_silent is true to stop reporting.
+	 */
+	void setSilent(bool in_silent);
+	/**
+	 * Checks if the reporter is silent.
+	 * \return true if nothing is being reported.
+	 */
+	bool isSilent() const;
+
+	/**
+	 * Publishes the metrics of a generation, if it is due to be reported. It never blocks.
+	 * \param metrics is the metrics of the generation.
+	 * \return true if the generation was queued to be written.
+	 */
+	bool publish(const GenerationMetrics & metrics);
+	/**
+	 * Waits until everything published so far has been written to the stream.
+	 */
+	void flush();
+
+	/**
+	 * Gets the number of generations dropped because the queue was full.
+	 * \return the number of generations dropped.
+	 */
+	unsigned long long getNumDropped() const;
+
+private:
+	/**
+	 * The reporter cannot be copied.
+	 */
+	Reporter(const Reporter & other);
+	/**
+	 * The reporter cannot be assigned.
+	 */
+	Reporter & operator=(const Reporter & other);
+
+	/**
+	 * Checks if a generation should be reported.
+	 * \param metrics is the metrics of the generation.
+	 * \return true if it is due.
+	 */
+	bool isDue(const GenerationMetrics & metrics);
+	/**
+	 * The loop the writer thread runs until the reporter is destroyed.
+	 */
+	void writerLoop();
+	/**
+	 * Writes out every generation waiting in the queue.
+	 * \return true if anything was written.
+	 */
+	bool writeQueued();
+
+	/**
+	 * The stream the reports are written to.
+	 */
+	std::ostream & os;
+	/**
+	 * The queue of generations waiting to be written. Its size is a power of 2.
+	 */
+	std::vector<GenerationMetrics> queue;
+	/**
+	 * The number of generations ever put in the queue. Only the publisher writes it.
+	 */
+	std::atomic<unsigned long long> tail;
+	/**
+	 * The number of generations ever taken out of the queue. Only the writer thread writes it.
+	 */
+	std::atomic<unsigned long long> head;
+	/**
+	 * The number of generations written out and flushed to the stream.
+	 */
+	std::atomic<unsigned long long> written;
+	/**
+	 * The number of generations dropped because the queue was full.
+	 */
+	std::atomic<unsigned long long> dropped;
+
+	/**
+	 * Report every generation that is a multiple of this, 0 for none.
+	 */
+	unsigned int every_generations;
+	/**
+	 * Report a generation if this many milliseconds have passed since the last one, 0 for none.
+	 */
+	unsigned int every_milliseconds;
+	/**
+	 * The wall time of the last generation reported.
+	 */
+	double last_report_time;
+	/**
+	 * True if nothing is reported.
+	 */
+	std::atomic<bool> silent;
+
+	/**
+	 * The writer thread.
+	 */
+	std::thread writer;
+	/**
+	 * Guards the waits of the writer thread. The publisher never takes it.
+	 */
+	std::mutex writer_mutex;
+	/**
+	 * Wakes the writer thread when the reporter is flushed or destroyed.
+	 */
+	std::condition_variable writer_wake;
+	/**
+	 * Wakes flush() when the writer thread has written out more generations.
+	 */
+	std::condition_variable writer_done;
+	/**
+	 * True when the reporter is being destroyed.
+	 */
+	bool stopping;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <sstream>
+
+#include "SharedMemoryMigration.h"
+#include "SharedMigrantRing.h"
+#include "GeneticAlgorithm.h"
+#include "Population.h"
+#include "Genome.h"
+
+using namespace std;
+
+SharedMemoryMigration::SharedMemoryMigration(const string & base_name, int in_island, int in_num_islands,
+	unsigned long long seed)
+	: island(in_island), topology(MIGRATION_TOPOLOGY), migration_interval(MIGRATION_INTERVAL),
+	  num_migrants(NUM_MIGRANTS), rng(seed)
+{
+	for(int i = 0; i < in_num_islands; ++i)
+		rings.push_back(new SharedMigrantRing(getRingName(base_name, i)));
+}
+
+SharedMemoryMigration::~SharedMemoryMigration()
+{
+	for(vector<SharedMigrantRing *>::iterator it = rings.begin();
+		it != rings.end();
+		++it)
+	{
+		delete *it;
+	}
+}
+
+string SharedMemoryMigration::getRingName(const string & base_name, int island)
+{
+	ostringstream name;
+	name << base_name << "_" << island;
+	return name.str();
+}
+
+bool SharedMemoryMigration::isOpen() const
+{
+	for(vector<SharedMigrantRing *>::const_iterator it = rings.begin();
+		it != rings.end();
+		++it)
+	{
+		if(!(*it)->isOpen())
+			return false;
+	}
+	return true;
+}
+
+void SharedMemoryMigration::setTopology(int in_topology)
+{
+	topology = in_topology;
+}
+
+void SharedMemoryMigration::setMigrationInterval(unsigned int interval)
+{
+	migration_interval = interval;
+}
+
+void SharedMemoryMigration::setNumMigrants(unsigned int num)
+{
+	num_migrants = num;
+}
+
+void SharedMemoryMigration::migrate(GeneticAlgorithm & ga)
+{
+	int num_islands = (int)rings.size();
+	if(num_islands < 2 || migration_interval == 0 || ga.getGeneration() % migration_interval != 0)
+		return;
+
+	Population *pop = ga.getPopulation();
+	if(pop->getPopSize() == 0 || pop->getGenome(0)->packedSize() == 0)
+		return;
+
+	// send packed copies of the best genomes on
+	int destination = chooseDestination(island, num_islands, topology, rng);
+
+	unsigned int num_sent = num_migrants < (unsigned int)pop->getPopSize() ? num_migrants : pop->getPopSize();
+	pop->sortElite(num_sent);
+	for(unsigned int i = 0; i < num_sent; ++i)
+	{
+		Genome *genome = pop->getGenome(i);
+		message.resize(genome->packedSize());
+		genome->pack(&message[0]);
+
+		// a full ring means the other island is behind, the migrant is just dropped
+		rings[destination]->push(&message[0], (unsigned int)message.size());
+	}
+
+	// take in whatever has arrived since last time in place of the worst genomes
+	while(rings[island]->pop(message))
+	{
+		// the migrant is unpacked on this island's thread, so it can come from the population's pool
+		Genome *genome = pop->getGenomePool().acquire(*pop->getGenome(0));
+		if(!message.empty() && genome->unpack(&message[0], (unsigned int)message.size()))
+			arrivals.push_back(genome);
+		else
+			pop->getGenomePool().release(genome);
+	}
+	if(!arrivals.empty())
+	{
+		pop->replaceWorst(arrivals);
+		ga.init();
+	}
+}
@@ -0,0 +1,121 @@
+#ifndef SHAREDMEMORYMIGRATION_H
+#define SHAREDMEMORYMIGRATION_H
+
+/**
+ * \file SharedMemoryMigration.h
+ */
+
+#include "Migration.h"
+#include "Random.h"
+#include "config.h"
+#include <string>
+#include <vector>
+
+class Genome;
+class SharedMigrantRing;
+
+/**
+ * This class is the migration hook of an island that runs in its own process. Every island
+ * has a SharedMigrantRing named after it, created before the islands start. Every
+ * interval generations the island packs copies of its best genomes into the ring of
+ * another island, then unpacks whatever is in its own ring in place of its worst genomes.
+ * Only genomes that can be packed, like TSPIndexGenome, can migrate.
+ */
+class SharedMemoryMigration : public Migration
+{
+public:
+	/**
+	 * Overloaded constructor. Opens the ring of every island.
+	 * \param base_name is the name the rings were created with by getRingName().
+	 * \param in_island is the index of this island.
+	 * \param in_num_islands is the number of islands.
+	 * \param seed is the seed of the choice of random destinations.
+	 */
+	SharedMemoryMigration(const std::string & base_name, int in_island, int in_num_islands,
+		unsigned long long seed);
+	/**
+	 * Destructor. Closes the rings.
+	 */
+	~SharedMemoryMigration();
+
+	/**
+	 * Gets the name of the ring of an island.
+	 * \param base_name is the name shared by all the islands of a run.
+	 * \param island is the index of the island.
+	 * \return the name of the shared memory.
+	 */
+	static std::string getRingName(const std::string & base_name, int island);
+
+	/**
+	 * Checks if the ring of every island was opened.
+	 * \return true if the island can migrate.
+	 */
+	bool isOpen() const;
+
+	/**
+	 * Sets where the migrants go.
+	 * \param in_topology is RING_TOPOLOGY or RANDOM_TOPOLOGY. It defaults to MIGRATION_TOPOLOGY.
+	 */
+	void setTopology(int in_topology);
+	/**
+	 * Sets how often the island migrates.
+	 * \param interval is the number of generations between migrations. It defaults to MIGRATION_INTERVAL.
+	 */
+	void setMigrationInterval(unsigned int interval);
+	/**
+	 * Sets how many genomes the island sends when it migrates.
+	 * \param num is the number of migrants. It defaults to NUM_MIGRANTS.
+	 */
+	void setNumMigrants(unsigned int num);
+
+	/**
+	 * Sends the best genomes and takes in the ones that have arrived.
+	 * \param ga is the genetic algorithm of this island.
+	 */
+	void migrate(GeneticAlgorithm & ga);
+
+private:
+	/**
+	 * The migration cannot be copied.
+	 */
+	SharedMemoryMigration(const SharedMemoryMigration & other);
+	/**
+	 * The migration cannot be assigned.
+	 */
+	SharedMemoryMigration & operator=(const SharedMemoryMigration & other);
+
+	/**
+	 * The ring of every island, indexed by island.
+	 */
+	std::vector<SharedMigrantRing *> rings;
+	/**
+	 * The index of this island.
+	 */
+	int island;
+	/**
+	 * RING_TOPOLOGY or RANDOM_TOPOLOGY.
+	 */
+	int topology;
+	/**
+	 * The number of generations between migrations.
+	 */
+	unsigned int migration_interval;
+	/**
+	 * The number of genomes sent each migration.
+	 */
+	unsigned int num_migrants;
+	/**
+	 * Picks the random destinations.
+	 */
+	Random rng;
+	/**
+	 * A packed genome, kept so it does not have to be reallocated.
+	 */
+	std::vector<char> message;
+	/**
+	 * The genomes that have arrived, kept so it does not have to be reallocated.
+	 */
+	std::vector<Genome *> arrivals;
+};
+
+#endif
@@ -0,0 +1,214 @@
+#include <iostream>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "SharedMigrantRing.h"
+
+using namespace std;
+
+// the atomics live in memory shared between processes, so they must not hide a lock
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "the shared ring needs lock-free 64 bit atomics");
+
+// the start of the shared memory
+struct RingHeader
+{
+	atomic<unsigned long long> enqueue_pos;
+	char enqueue_pad[64 - sizeof(atomic<unsigned long long>)];
+	atomic<unsigned long long> dequeue_pos;
+	char dequeue_pad[64 - sizeof(atomic<unsigned long long>)];
+	unsigned int num_slots;
+	unsigned int slot_size;
+	unsigned int slot_stride;
+};
+
+// the start of every slot, the message follows it
+struct SlotHeader
+{
+	atomic<unsigned long long> sequence;
+	unsigned int size;
+};
+
+static const unsigned long HEADER_SIZE = (sizeof(RingHeader) + 63) / 64 * 64;
+
+// checks that a ring opened by name has the layout of one made by this class and fits in
+// the memory mapped, so a stale or foreign segment cannot send a push or pop out of bounds
+static bool IsValidLayout(const char *memory, unsigned long size)
+{
+	const RingHeader *header = (const RingHeader *)memory;
+	unsigned int slots = header->num_slots;
+	if(slots == 0 || (slots & (slots - 1)) != 0)
+		return false;
+	if((unsigned long long)header->slot_stride < sizeof(SlotHeader) + (unsigned long long)header->slot_size ||
+		header->slot_stride % 64 != 0)
+		return false;
+	return HEADER_SIZE + (unsigned long long)slots * header->slot_stride <= size;
+}
+
+SharedMigrantRing::SharedMigrantRing(const string & name, unsigned int num_slots, unsigned int slot_size)
+	: ring_name(name), owner(true), memory(0), memory_size(0)
+{
+	unsigned int slots = 1;
+	while(slots < num_slots)
+		slots *= 2;
+
+	// each slot starts on its own cache line
+	unsigned int stride = (unsigned int)((sizeof(SlotHeader) + slot_size + 63) / 64 * 64);
+
+	shm_unlink(name.c_str());
+	int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if(fd < 0)
+		return;
+
+	unsigned long size = HEADER_SIZE + (unsigned long)slots * stride;
+	if(ftruncate(fd, size) != 0 || !map(fd, size))
+	{
+		close(fd);
+		shm_unlink(name.c_str());
+		return;
+	}
+	close(fd);
+
+	RingHeader *header = new (memory) RingHeader;
+	header->enqueue_pos.store(0);
+	header->dequeue_pos.store(0);
+	header->num_slots = slots;
+	header->slot_size = slot_size;
+	header->slot_stride = stride;
+
+	// a slot is free for the push at position pos when its sequence is pos
+	for(unsigned int i = 0; i < slots; ++i)
+	{
+		SlotHeader *s = new (memory + HEADER_SIZE + (unsigned long)i * stride) SlotHeader;
+		s->sequence.store(i, memory_order_release);
+	}
+}
+
+SharedMigrantRing::SharedMigrantRing(const string & name)
+	: ring_name(name), owner(false), memory(0), memory_size(0)
+{
+	int fd = shm_open(name.c_str(), O_RDWR, 0600);
+	if(fd < 0)
+		return;
+
+	struct stat info;
+	if(fstat(fd, &info) == 0 && (unsigned long)info.st_size >= HEADER_SIZE)
+		map(fd, (unsigned long)info.st_size);
+	close(fd);
+
+	if(memory && !IsValidLayout(memory, memory_size))
+	{
+		munmap(memory, memory_size);
+		memory = 0;
+		memory_size = 0;
+	}
+}
+
+SharedMigrantRing::~SharedMigrantRing()
+{
+	if(memory)
+		munmap(memory, memory_size);
+	if(owner && memory)
+		shm_unlink(ring_name.c_str());
+}
+
+bool SharedMigrantRing::map(int fd, unsigned long size)
+{
+	void *address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(address == MAP_FAILED)
+		return false;
+
+	memory = (char *)address;
+	memory_size = size;
+	return true;
+}
+
+bool SharedMigrantRing::isOpen() const
+{
+	return memory != 0;
+}
+
+unsigned int SharedMigrantRing::getSlotSize() const
+{
+	return memory ? ((RingHeader *)memory)->slot_size : 0;
+}
+
+char * SharedMigrantRing::slot(unsigned long long pos) const
+{
+	const RingHeader *header = (const RingHeader *)memory;
+	return memory + HEADER_SIZE + (unsigned long)(pos & (header->num_slots - 1)) * header->slot_stride;
+}
+
+bool SharedMigrantRing::push(const char *data, unsigned int size)
+{
+	if(!memory)
+		return false;
+
+	RingHeader *header = (RingHeader *)memory;
+	if(size > header->slot_size)
+		return false;
+
+	unsigned long long pos = header->enqueue_pos.load(memory_order_relaxed);
+	SlotHeader *s;
+	for(;;)
+	{
+		s = (SlotHeader *)slot(pos);
+		long long diff = (long long)(s->sequence.load(memory_order_acquire) - pos);
+		if(diff == 0)
+		{
+			// the slot is free, claim it
+			if(header->enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+				break;
+		}
+		else if(diff < 0)
+			return false; // the slot still holds a message from a lap ago, so the ring is full
+		else
+			pos = header->enqueue_pos.load(memory_order_relaxed);
+	}
+
+	s->size = size;
+	memcpy((char *)s + sizeof(SlotHeader), data, size);
+
+	// hand the slot to the pop at the same position
+	s->sequence.store(pos + 1, memory_order_release);
+	return true;
+}
+
+bool SharedMigrantRing::pop(vector<char> & data)
+{
+	if(!memory)
+		return false;
+
+	RingHeader *header = (RingHeader *)memory;
+
+	unsigned long long pos = header->dequeue_pos.load(memory_order_relaxed);
+	SlotHeader *s;
+	for(;;)
+	{
+		s = (SlotHeader *)slot(pos);
+		long long diff = (long long)(s->sequence.load(memory_order_acquire) - (pos + 1));
+		if(diff == 0)
+		{
+			// the slot is full, claim it
+			if(header->dequeue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+				break;
+		}
+		else if(diff < 0)
+			return false; // nothing has been pushed here yet, so the ring is empty
+		else
+			pos = header->dequeue_pos.load(memory_order_relaxed);
+	}
+
+	// a size that does not fit the slot can only come from a broken writer, give back an empty message
+	unsigned int size = (s->size <= header->slot_size) ? s->size : 0;
+	data.assign((char *)s + sizeof(SlotHeader), (char *)s + sizeof(SlotHeader) + size);
+
+	// free the slot for the push one lap later
+	s->sequence.store(pos + header->num_slots, memory_order_release);
+	return true;
+}
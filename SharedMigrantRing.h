@@ -0,0 +1,107 @@
+#ifndef SHAREDMIGRANTRING_H
+#define SHAREDMIGRANTRING_H
+
+/**
+ * \file SharedMigrantRing.h
+ */
+
+#include <string>
+#include <vector>
+
+/**
+ * This class is a ring buffer of packed genomes in POSIX shared memory, so islands running
+ * in separate processes on the same machine can send genomes to each other. One process
+ * creates the ring and the others open it by name. Any number of processes can push and
+ * pop at once without locks: each slot carries a sequence number that says whether it is
+ * free, being written, or full. A push to a full ring fails instead of waiting.
+ */
+class SharedMigrantRing
+{
+public:
+	/**
+	 * Overloaded constructor. Creates the ring, replacing any old ring with the same name.
+	 * The ring is removed again when this object is destroyed.
+	 * \param name is the name of the shared memory, starting with a '/'.
+	 * \param num_slots is the number of messages the ring can hold. It is rounded up to a power of 2.
+	 * \param slot_size is the largest message in bytes.
+	 */
+	SharedMigrantRing(const std::string & name, unsigned int num_slots, unsigned int slot_size);
+	/**
+	 * Overloaded constructor. Opens a ring created by another process. The ring is not opened
+	 * if the shared memory is too small for the slots its header describes.
+	 * \param name is the name of the shared memory.
+	 */
+	SharedMigrantRing(const std::string & name);
+	/**
+	 * Destructor. Unmaps the ring, and removes it if this object created it.
+	 */
+	~SharedMigrantRing();
+
+	/**
+	 * Checks if the ring was created or opened.
+	 * \return true if the ring can be used.
+	 */
+	bool isOpen() const;
+	/**
+	 * Gets the largest message the ring can hold.
+	 * \return the size of a slot in bytes.
+	 */
+	unsigned int getSlotSize() const;
+
+	/**
+	 * Copies a message into the ring.
+	 * \param data is the message.
+	 * \param size is the number of bytes in the message.
+	 * \return false if the ring is full or the message is too big.
+	 */
+	bool push(const char *data, unsigned int size);
+	/**
+	 * Takes the oldest message out of the ring.
+	 * \param data gets the message.
+	 * \return false if the ring is empty.
+	 */
+	bool pop(std::vector<char> & data);
+
+private:
+	/**
+	 * The ring cannot be copied.
+	 */
+	SharedMigrantRing(const SharedMigrantRing & other);
+	/**
+	 * The ring cannot be assigned.
+	 */
+	SharedMigrantRing & operator=(const SharedMigrantRing & other);
+
+	/**
+	 * Maps the shared memory.
+	 * \param fd is the open shared memory.
+	 * \param size is the number of bytes to map.
+	 * \return true if it was mapped.
+	 */
+	bool map(int fd, unsigned long size);
+	/**
+	 * Gets a slot of the ring.
+	 * \param pos is the position of the message, it wraps around the ring.
+	 * \return the start of the slot.
+	 */
+	char * slot(unsigned long long pos) const;
+
+	/**
+	 * The name of the shared memory.
+	 */
+	std::string ring_name;
+	/**
+	 * True if this object created the shared memory and should remove it.
+	 */
+	bool owner;
+	/**
+	 * The start of the mapped memory, 0 if it is not mapped.
+	 */
+	char *memory;
+	/**
+	 * The number of bytes mapped.
+	 */
+	unsigned long memory_size;
+};
+
+#endif
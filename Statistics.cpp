@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cmath>
 
 #include "Statistics.h"
 #include "Population.h"
@@ -7,103 +8,181 @@
 using namespace std;
 
 Statistics::Statistics()
-	: generation_num(0)
-
+	: generation_num(0), current_pop(0), best_pop_generation(0), worst_pop_generation(0),
+	  best_genome_ever(0), best_genome_generation(0), worst_score_ever(0.0), worst_genome_generation(0),
+	  history(METRIC_HISTORY_SIZE), start_time(std::chrono::steady_clock::now())
 {
 
 }
 
 Statistics::Statistics(const Statistics & other)
-	: generation_num(0)
+	: generation_num(other.generation_num), current_pop(other.current_pop),
+	  first_summary(other.first_summary), best_summary(other.best_summary), worst_summary(other.worst_summary),
+	  best_pop_generation(other.best_pop_generation), worst_pop_generation(other.worst_pop_generation),
+	  best_genome_ever(other.best_genome_ever ? other.best_genome_ever->clone() : 0),
+	  best_genome_generation(other.best_genome_generation),
+	  worst_score_ever(other.worst_score_ever), worst_genome_generation(other.worst_genome_generation),
+	  history(other.history), start_time(other.start_time)
 {
 
 }
 
 Statistics::~Statistics()
 {
-	delete first_pop;
-	delete best_pop;
-	delete worst_pop;
 	delete best_genome_ever;
-	delete worst_genome_ever;
+}
 
+bool Statistics::isBetter(double s1, double s2)
+{
+	if(HIGH_LOW == LOW_IS_BEST)
+		return s1 < s2;
+	else
+		return s1 > s2;
 }
 
 void Statistics::init(Population *pop)
 {
 	// update current pop
 	current_pop = pop;
+	generation_num = 0;
 
-	first_pop = new Population(*pop);
-
-	best_pop = new Population(*pop);
-	worst_pop = new Population(*pop);
+	first_summary = pop->getSummary();
+	best_summary = first_summary;
+	worst_summary = first_summary;
+	best_pop_generation = 0;
+	worst_pop_generation = 0;
 
-	best_genome_ever = pop->getBestGenome().clone();
-	worst_genome_ever = pop->getWorstGenome().clone();
+	// an empty population has no genomes to remember yet, update() picks up the first ones
+	delete best_genome_ever;
+	best_genome_ever = 0;
+	best_genome_generation = 0;
+	worst_score_ever = 0.0;
+	worst_genome_generation = 0;
+	if(first_summary.best_index >= 0)
+	{
+		best_genome_ever = pop->getBestGenome().clone();
+		worst_score_ever = pop->getWorstGenome().getScore();
+	}
 
+	history.clear();
+	start_time = std::chrono::steady_clock::now();
+	recordMetrics(*pop);
 }
 
-void Statistics::update(Population *pop)
+bool Statistics::update(Population *pop)
 {
 	++generation_num; // update the generation number
 
 	// update current pop
 	current_pop = pop;
 
-	if(HIGH_LOW == LOW_IS_BEST)
+	// one pass over the population gives everything we compare against
+	const PopulationSummary & summary = pop->getSummary();
+
+	// update best/worst populations (this is based on the total score of the pop)
+	if(isBetter(summary.total_score, best_summary.total_score))
 	{
-		// update best/worst populations (this is based on the total fitness of the pop)
-		if(best_pop->getTotalScore() > pop->getTotalScore())
-		{
-			*best_pop = *pop;
-		}
+		best_summary = summary;
+		best_pop_generation = generation_num;
+	}
+	if(isBetter(worst_summary.total_score, summary.total_score))
+	{
+		worst_summary = summary;
+		worst_pop_generation = generation_num;
+	}
 
-		if(worst_pop->getTotalScore() < pop->getTotalScore())
+	// update the best genome and worst score ever
+	bool new_best = false;
+	if(summary.best_index >= 0)
+	{
+		bool first_genomes = (best_genome_ever == 0);
+		Genome & best = pop->getBestGenome();
+		new_best = first_genomes || isBetter(best.getScore(), best_genome_ever->getScore());
+		if(first_genomes)
+			best_genome_ever = best.clone();
+		else if(new_best)
+			best_genome_ever->copy(best);
+		if(new_best)
+			best_genome_generation = generation_num;
+
+		double worst_score = pop->getWorstGenome().getScore();
+		if(first_genomes || isBetter(worst_score_ever, worst_score))
 		{
-			*worst_pop = *pop;
+			worst_score_ever = worst_score;
+			worst_genome_generation = generation_num;
 		}
+	}
 
-		// update the best/worst genomes ever (based on fitness)
-		if(best_genome_ever->getScore() > pop->getBestGenome().getScore())
-		{
-			delete best_genome_ever;
-			best_genome_ever = pop->getBestGenome().clone();
-		}
+	recordMetrics(*pop);
+	return new_best;
+}
 
-		if(worst_genome_ever->getScore() < pop->getWorstGenome().getScore())
-		{
-			delete worst_genome_ever;
-			worst_genome_ever = pop->getWorstGenome().clone();
-		}
-	}
-	else
-	{
-		// HIGH IS BEST
-		// update best/worst populations (this is based on the total fitness of the pop)
-		if(best_pop->getTotalScore() < pop->getTotalScore())
-		{
-			*best_pop = *pop;
-		}
+void Statistics::recordMetrics(const Population & pop)
+{
+	const PopulationSummary & summary = pop.getSummary();
+
+	GenerationMetrics metrics;
+	metrics.generation = generation_num;
+	metrics.best_score = (HIGH_LOW == LOW_IS_BEST) ? summary.min_score : summary.max_score;
+	metrics.mean_score = summary.ave_score;
+	metrics.worst_score = (HIGH_LOW == LOW_IS_BEST) ? summary.max_score : summary.min_score;
+	metrics.score_stddev = sqrt(summary.score_variance);
+	metrics.diversity = pop.getDiversity();
+	metrics.evaluations = pop.getEvaluationCount();
+	metrics.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	history.record(metrics);
+}
 
-		if(worst_pop->getTotalScore() > pop->getTotalScore())
-		{
-			*worst_pop = *pop;
-		}
+int Statistics::getGeneration() const
+{
+	return generation_num;
+}
 
-		// update the best/worst genomes ever (based on fitness)
-		if(best_genome_ever->getScore() < pop->getBestGenome().getScore())
-		{
-			delete best_genome_ever;
-			best_genome_ever = pop->getBestGenome().clone();
-		}
+const PopulationSummary & Statistics::getFirstSummary() const
+{
+	return first_summary;
+}
 
-		if(worst_genome_ever->getScore() > pop->getWorstGenome().getScore())
-		{
-			delete worst_genome_ever;
-			worst_genome_ever = pop->getWorstGenome().clone();
-		}
-	}
+const PopulationSummary & Statistics::getBestSummary() const
+{
+	return best_summary;
+}
+
+const PopulationSummary & Statistics::getWorstSummary() const
+{
+	return worst_summary;
+}
+
+const Genome * Statistics::getBestGenomeEver() const
+{
+	return best_genome_ever;
+}
+
+int Statistics::getBestGenomeGeneration() const
+{
+	return best_genome_generation;
+}
+
+double Statistics::getWorstScoreEver() const
+{
+	return worst_score_ever;
+}
+
+const MetricHistory & Statistics::getHistory() const
+{
+	return history;
+}
+
+// writes a population summary the way the population writes itself, without the genomes
+static void writeSummary(ostream & os, const PopulationSummary & summary, int generation)
+{
+	os << "Generation: " << generation << endl;
+	os << "Total Score: " << summary.total_score << endl;
+	os << "Total Fitness: " << summary.total_fitness << endl;
+	os << "Average Score: " << summary.ave_score << endl;
+	os << "Average Fitness: " << summary.ave_fitness << endl;
+	os << "Lowest Score: " << summary.min_score << endl;
+	os << "Highest Score: " << summary.max_score << endl;
 }
 
 ostream & operator<<(ostream & os, const Statistics & stats)
@@ -112,17 +191,24 @@ ostream & operator<<(ostream & os, const Statistics & stats)
 	os << "              STATISTICS after " << stats.generation_num << " Generations" << endl;
 	os << "**************************************************************" << endl;
 	os << "***********************First Population***********************" << endl;
-	os << *stats.first_pop << endl;
+	writeSummary(os, stats.first_summary, 0);
+	os << endl;
 	os << "***********************Last Population***********************" << endl;
-	os << *stats.current_pop << endl;
+	if(stats.current_pop)
+		os << *stats.current_pop << endl;
 	os << "************************Best Population***********************" << endl;
-	os << *stats.best_pop << endl;
+	writeSummary(os, stats.best_summary, stats.best_pop_generation);
+	os << endl;
 	os << "***********************Worst Population***********************" << endl;
-	os << *stats.worst_pop << endl;
+	writeSummary(os, stats.worst_summary, stats.worst_pop_generation);
+	os << endl;
 	os << "***********************Best Genome Ever***********************" << endl;
-	os << *stats.best_genome_ever << endl;
+	os << "Generation: " << stats.best_genome_generation << endl;
+	if(stats.best_genome_ever)
+		os << *stats.best_genome_ever << endl;
 	os << "***********************Worst Genome Ever**********************" << endl;
-	os << *stats.worst_genome_ever << endl;
+	os << "Generation: " << stats.worst_genome_generation << endl;
+	os << "Genome Score: " << stats.worst_score_ever << endl;
 
 	return os;
-}
\ No newline at end of file
+}
@@ -7,11 +7,16 @@
  * \date 10 April 2006
  */
 
+#include "Population.h"
+#include "MetricHistory.h"
+#include <chrono>
+
 class Genome;
-class Population;
 
 /**
  * This class is used to hold statistics about the genetic algorithm.
+ * It keeps the summaries of the first, best and worst populations and a copy of the best
+ * genome ever, never whole populations, so it takes the same memory however long the run.
  */
 class Statistics
 {
@@ -32,18 +37,62 @@ public:
 
 	/**
 	* This function will initialize the stats object. It will set the best/worst population 
-	* to the current population and the best/worst genomes to the best/worst genomes of the 
-	* current popualtion.
+	* summaries to the summary of the current population and the best genome ever to the
+	* best genome of the current popualtion, if it has any. The metrics of the population are the first in the history.
 	* \param pop is the population
 	*/
 	void init(Population *pop);
 
 	/**
-	* This function will update the best/worst populations, and also the best/worst genomes ever.
-	* It will write the current population to file.
+	* This function will update the best/worst population summaries, and also the best genome
+	* and worst score ever. The best genome ever is overwritten in place, so this does not
+	* allocate once it has been made. It is called once for each new generation.
 	* \param pop is the population to be used to update the stats object.
+	* \return true if the population holds a better genome than any seen before.
+	*/
+	bool update(Population *pop);
+
+	/**
+	* Gets the number of generations the stats object has seen.
+	* \return the number of updates since init().
+	*/
+	int getGeneration() const;
+	/**
+	* Gets the summary of the population the stats object was initialized with.
+	* \return a reference to the summary.
+	*/
+	const PopulationSummary & getFirstSummary() const;
+	/**
+	* Gets the summary of the population with the best total score so far.
+	* \return a reference to the summary.
+	*/
+	const PopulationSummary & getBestSummary() const;
+	/**
+	* Gets the summary of the population with the worst total score so far.
+	* \return a reference to the summary.
+	*/
+	const PopulationSummary & getWorstSummary() const;
+	/**
+	* Gets a copy of the best genome seen so far.
+	* \return a pointer to the genome, 0 before init().
+	*/
+	const Genome * getBestGenomeEver() const;
+	/**
+	* Gets the update the best genome ever was found in.
+	* \return the number of updates since init() when it was found, 0 if it was in the first population.
+	*/
+	int getBestGenomeGeneration() const;
+	/**
+	* Gets the score of the worst genome seen so far.
+	* \return the worst score.
+	*/
+	double getWorstScoreEver() const;
+	/**
+	* Gets the metrics of the last METRIC_HISTORY_SIZE generations. They can be
+	* written to a CSV or binary file from there.
+	* \return a reference to the history.
 	*/
-	void update(Population *pop);
+	const MetricHistory & getHistory() const;
 
 	/**
 	 * Copy Constructor
@@ -54,6 +103,19 @@ public:
 	friend std::ostream & operator<<(std::ostream & os, const Statistics & stats);
 
 private:
+	/**
+	 * Checks if one score is better than another, following HIGH_LOW.
+	 * \param s1 is the first score.
+	 * \param s2 is the second score.
+	 * \return true if s1 is better than s2.
+	 */
+	static bool isBetter(double s1, double s2);
+	/**
+	 * Adds the metrics of the current population to the history.
+	 * \param pop is the current population.
+	 */
+	void recordMetrics(const Population & pop);
+
 	/**
 	 * The generation number of the population.
 	 */
@@ -63,26 +125,49 @@ private:
 	 */
 	Population *current_pop;
 	/**
-	 * A pointer to the best population ever.
+	 * The summary of the first population.
+	 */
+	PopulationSummary first_summary;
+	/**
+	 * The summary of the best population ever.
+	 */
+	PopulationSummary best_summary;
+	/**
+	 * The summary of the worst population ever.
 	 */
-	Population *best_pop;
+	PopulationSummary worst_summary;
 	/**
-	 * A pointer to the worst population ever.
+	 * The generation of the best population ever.
 	 */
-	Population *worst_pop;
+	int best_pop_generation;
 	/**
-	 * A pointer to the first population.
+	 * The generation of the worst population ever.
 	 */
-	Population *first_pop;
+	int worst_pop_generation;
 	/**
-	 * A pointer to the best genome ever population.
+	 * A copy of the best genome ever, 0 before init().
 	 */
 	Genome *best_genome_ever;
 	/**
-	 * A pointer to the worst genome ever population.
+	 * The generation the best genome ever was found in.
 	 */
-	Genome *worst_genome_ever;
-
+	int best_genome_generation;
+	/**
+	 * The score of the worst genome ever.
+	 */
+	double worst_score_ever;
+	/**
+	 * The generation the worst genome ever was found in.
+	 */
+	int worst_genome_generation;
+	/**
+	 * The metrics of the most recent generations.
+	 */
+	MetricHistory history;
+	/**
+	 * When init() was called, the wall times are measured from it.
+	 */
+	std::chrono::steady_clock::time_point start_time;
 };
 
 #endif
\ No newline at end of file
@@ -4,104 +4,195 @@
 #include "Genome.h"
 #include "Random.h"
 #include "Population.h"
+#include "ThreadPool.h"
+#include "GenomePool.h"
 #include <cmath>
 
 using namespace std;
 
 SteadyStateGA::SteadyStateGA()
-	: GeneticAlgorithm(), replace_percentage(0.50), objRand(new Random())
+	: GeneticAlgorithm(), replace_percentage(0.50), objRand(new Random()), reproduction_pool(0),
+	  deterministic(DETERMINISTIC_REPRODUCTION != 0)
 {
-
+	stream_key = objRand->randomBits();
+	setReproductionThreads(REPRODUCTION_THREADS);
 }
 
 SteadyStateGA::SteadyStateGA(const SteadyStateGA & ss_ga)
-	: GeneticAlgorithm(), replace_percentage(ss_ga.replace_percentage), objRand(new Random())
+	: GeneticAlgorithm(), replace_percentage(ss_ga.replace_percentage), objRand(new Random()), reproduction_pool(0),
+	  deterministic(ss_ga.deterministic)
 {
-
+	stream_key = objRand->randomBits();
+	setReproductionThreads(REPRODUCTION_THREADS);
 }
 
 SteadyStateGA::SteadyStateGA(Population *pop)
-	: GeneticAlgorithm(pop), replace_percentage(0.50), objRand(new Random())
+	: GeneticAlgorithm(pop), replace_percentage(0.50), objRand(new Random()), reproduction_pool(0),
+	  deterministic(DETERMINISTIC_REPRODUCTION != 0)
 {
-	
+	stream_key = objRand->randomBits();
+	setReproductionThreads(REPRODUCTION_THREADS);
 }
 
 SteadyStateGA::~SteadyStateGA()
 {
 	delete objRand;
+	delete reproduction_pool;
 }
 
 void SteadyStateGA::init()
 {
+	// evaluates the genomes that changed and finds the best and worst
 	pop->initialize();
-	pop->evaluatePopulationScores();
 	pop->evaluatePopulationFitnesses();
 }
 
+// makes the children from begin to end. Every child has its own slot in the
+// next population, filled with a genome from the pool before the threads start,
+// so the threads never write to the same place and never allocate. With a stream key
+// each child reseeds the thread's generator from (key, generation, child), so what it
+// draws does not depend on which thread makes it.
+class ReproduceTask : public ParallelTask
+{
+public:
+	ReproduceTask(Population & in_pop, const vector<int> & in_parents, vector<Genome *> & in_children,
+		int in_first_slot, vector<Random> & in_rands, bool in_keyed, unsigned long long in_key, int in_generation)
+		: pop(in_pop), parents(in_parents), children(in_children), first_slot(in_first_slot), rands(in_rands),
+		  keyed(in_keyed), key(in_key), generation(in_generation) {}
+	void run(int begin, int end, unsigned int thread)
+	{
+		Random & rng = rands[thread];
+
+		for(int i = begin; i < end; ++i)
+		{
+			if(keyed)
+				rng.seed(key, (unsigned long long)generation, (unsigned long long)i);
+
+			Genome *dad = pop.getGenome(parents[2 * i]);
+			Genome *mom = pop.getGenome(parents[2 * i + 1]);
+
+			// the child is a recycled genome, it is overwritten in place
+			Genome *child = children[first_slot + i];
+
+			// if crossover does not happen make the children = to the parents
+			if(rng.randomPercentage() <= crossover_percentage)
+			{
+				// perform crossover
+				dad->crossover(*mom, *child, rng);
+			}
+			else
+			{
+				// make child and dad equal to each other
+				child->copy(*dad);
+			}
+
+			// chance of mutation to each of the children
+			if(rng.randomPercentage() <= mutation_percentage)
+				child->mutate(rng);
+		}
+	}
+private:
+	Population & pop;
+	const vector<int> & parents;
+	vector<Genome *> & children;
+	int first_slot;
+	vector<Random> & rands;
+	bool keyed;
+	unsigned long long key;
+	int generation;
+};
+
 void SteadyStateGA::nextGeneration()
 {
-	double cross_random;
-	double mutate_random;
+	int num_elite = (int)(pop->getPopSize() * replace_percentage);
 
-	// sort the population bases on the parameters
-	pop->sortPopulation();
+	// only the genomes we keep need to be in order, so the population is not fully sorted
+	pop->sortElite(num_elite);
 
-	vector<Genome *> *new_genomes = new vector<Genome *>;
+	// the rest of the population is replaced by children
+	int num_children = pop->getPopSize() - num_elite;
+	if(num_elite + num_children == 0)
+		return;
 
-	// we only replace replace_percentage of the population.
-	// decide which percentage to replace...the lowest scores... (-1) fitnesses
-	// reverse interate through and delete the genomes.
+	// the elite carry over as they are, the same genomes just move to the next generation
+	next_genomes.resize(num_elite + num_children);
+	for(int i = 0; i < num_elite; ++i)
+	{
+		next_genomes[i] = pop->getGenome(i);
+	}
 
-	// copy the top (pop_size * replacement_percentage) genomes into the new genome vector
-	for(int i = 0; i < (int)(pop->getPopSize() * replace_percentage); ++i)
+	// the slots of the children are filled up front, with genomes the population has
+	// finished with, so the children can be written into them from any thread
+	GenomePool & pool = pop->getGenomePool();
+	Genome & prototype = *pop->getGenome(0);
+	for(int i = num_elite; i < num_elite + num_children; ++i)
 	{
-		new_genomes->push_back(pop->getGenome(i)->clone());
+		next_genomes[i] = pool.acquire(prototype);
 	}
 
+	// select every dad and mom for this generation in one go
+	pop->selectParents(2 * num_children, parents);
 
-	// now i need to add 1 - pop->getPopSize() * replace_percentage more genomes
-	for(int i = 0; i < (int)(pop->getPopSize() - (pop->getPopSize() * replace_percentage)); ++i)
-	{
-		// need to select a dad and mom .. select...
-		Genome *dad = pop->select();
-		Genome *mom = pop->select();	
-	
+	ReproduceTask task(*pop, parents, next_genomes, num_elite, thread_rands,
+		deterministic, stream_key, current_generation);
+	if(reproduction_pool)
+		reproduction_pool->parallelFor(task, num_children);
+	else
+		task.run(0, num_children, 0);
 
-		// then create child for crossover.
-		Genome *child;
+	++current_generation;
 
-		cross_random = objRand->randomPercentage();
-		// if crossover does not happen make the children = to the parents
-		if(cross_random <= crossover_percentage)
-		{
-			// perform crossover
-			child = dad->crossover(*mom);
-		}
-		else
-		{
-			// make child and dad equal to each other
-			child = dad->clone();
+	// the old generation goes back to the pool for the next one, apart from the elite
+	// at its front which are still in the population
+	pop->swapPopGenomes(next_genomes);
+	next_genomes.erase(next_genomes.begin(), next_genomes.begin() + num_elite);
+	pool.release(next_genomes);
+	init(); // init the new population
+}
 
-		}
+void SteadyStateGA::setReproductionThreads(unsigned int num_threads)
+{
+	if(num_threads < 1)
+		num_threads = 1;
 
-		mutate_random = objRand->randomPercentage();
-		// chance of mutation to each of the children
-		if(mutate_random <= mutation_percentage)
-		{
-			// perform crossover
-			child->mutate();
-		}
+	delete reproduction_pool;
+	reproduction_pool = (num_threads > 1) ? new ThreadPool(num_threads) : 0;
 
-		if((int)new_genomes->size() < pop->getPopSize())
-			new_genomes->push_back(child);
+	splitThreadRands(num_threads);
+}
 
-	}
+unsigned int SteadyStateGA::getReproductionThreads() const
+{
+	return reproduction_pool ? reproduction_pool->getNumThreads() : 1;
+}
 
-	
-	++current_generation;
+void SteadyStateGA::setSeed(unsigned long long seed)
+{
+	objRand->seed(seed);
+	pop->setSeed(objRand->randomBits());
+	stream_key = objRand->randomBits();
+	splitThreadRands(getReproductionThreads());
+}
 
-	pop->setPopGenomes(new_genomes);
-	init(); // init the new population
+void SteadyStateGA::setDeterministic(bool in_deterministic)
+{
+	deterministic = in_deterministic;
+}
+
+bool SteadyStateGA::isDeterministic() const
+{
+	return deterministic;
+}
+
+void SteadyStateGA::splitThreadRands(unsigned int num_threads)
+{
+	// the streams are 2^128 numbers apart, so no two threads ever draw the same ones
+	Random streams(objRand->randomBits());
+	thread_rands.clear();
+	for(unsigned int i = 0; i < num_threads; ++i)
+	{
+		thread_rands.push_back(streams.split());
+	}
 }
 
 SteadyStateGA & SteadyStateGA::operator++()
@@ -9,8 +9,11 @@
 
 #include "config.h"
 class Population;
+class ThreadPool;
+class Genome;
 #include "GeneticAlgorithm.h"
 #include "Random.h"
+#include <vector>
 
 /**
  * This class is a derived class of the GeneticAlgorithm base class.
@@ -52,7 +55,47 @@ public:
 	 */
 	SteadyStateGA & operator++();
 
+	/**
+	 * Sets the number of threads used to make the children of each generation. With more
+	 * than one thread the children are split over a pool of workers that is kept for the
+	 * life of the genetic algorithm. Each thread writes its children straight into their
+	 * slots of the next population and draws from its own random number generator.
+	 * \param num_threads is the number of threads. It defaults to REPRODUCTION_THREADS.
+	 */
+	void setReproductionThreads(unsigned int num_threads);
+	/**
+	 * Gets the number of threads used to make the children of each generation.
+	 * \return the number of threads.
+	 */
+	unsigned int getReproductionThreads() const;
+	/**
+	 * Seeds every random number generator of the genetic algorithm and its population,
+	 * so a run can be repeated. The reproduction threads get independent streams split
+	 * from the seed.
+	 * \param seed is the seed.
+	 */
+	void setSeed(unsigned long long seed);
+	/**
+	 * Turns deterministic reproduction on or off. When it is on, each child draws from a
+	 * stream keyed by the seed, the generation and the index of the child instead of from
+	 * the stream of the thread that makes it. A seeded run then gives bit-identical
+	 * populations on any number of threads.
+	 * \param deterministic is true to key the streams by child. It defaults to DETERMINISTIC_REPRODUCTION.
+	 */
+	void setDeterministic(bool deterministic);
+	/**
+	 * Checks if each child draws from its own keyed stream.
+	 * \return true if reproduction does not depend on the number of threads.
+	 */
+	bool isDeterministic() const;
+
 private:
+	/**
+	 * Gives every reproduction thread its own stream, split from objRand.
+	 * \param num_threads is the number of threads.
+	 */
+	void splitThreadRands(unsigned int num_threads);
+
 	/**
 	 * The percentage of the population to be replaced each generation.
 	 */
@@ -62,6 +105,34 @@ private:
 	 * A pointer to a random object.
 	 */
 	Random *objRand;
+
+	/**
+	 * The indexes of the parents selected for the next generation, dad and mom in turn.
+	 * It is kept between generations so it does not have to be reallocated.
+	 */
+	std::vector<int> parents;
+	/**
+	 * The genomes of the next generation while it is being made. It is kept between
+	 * generations so it does not have to be reallocated.
+	 */
+	std::vector<Genome *> next_genomes;
+
+	/**
+	 * The workers used to make the children, 0 when they are made on one thread.
+	 */
+	ThreadPool *reproduction_pool;
+	/**
+	 * One random number generator for each reproduction thread, indexed by the thread.
+	 */
+	std::vector<Random> thread_rands;
+	/**
+	 * True when each child draws from a stream keyed by stream_key, the generation and the child.
+	 */
+	bool deterministic;
+	/**
+	 * The key of the per child streams. It is drawn from objRand whenever that is seeded.
+	 */
+	unsigned long long stream_key;
 };
 
 #endif
\ No newline at end of file
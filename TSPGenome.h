@@ -10,6 +10,7 @@
 #include "Genome.h"
 #include "City.h"
 #include "config.h"
+#include "Random.h"
 #include <vector>
 using std::vector;
 #include <cmath>
@@ -51,15 +52,22 @@ public:
 
 	/**
 	* Clones a genome of type TSPGenome. But premutes the cities of the genome it's cloning.
+	* \param rng is the random number generator to draw from.
 	* \return a pointer to a TSPGenome<T> object
 	*/
-	TSPGenome<T> * premuteClone();
+	TSPGenome<T> * premuteClone(Random & rng);
 
 	/**
 	* Copies the content of a genome
 	* \param orig is the original genome to copy from.
 	*/
 	void copy(const TSPGenome<T> & orig);	
+	/**
+	* Overwrites this genome with another one, score included. The cities this genome
+	* already has are reused, only their coordinates change.
+	* \param orig is the original genome to copy from. It must be a TSPGenome<T>.
+	*/
+	void copy(const Genome & orig);
 
 	/**
 	* evaluate this TSPGenome. It will set the score in the genome class (base class).
@@ -68,33 +76,38 @@ public:
 
 	/**
 	* initialize the TSPgenome. This will initialize a random premutation of cities
+	* \param rng is the random number generator the cities are positioned with.
 	*/
-	void initialize();
+	void initialize(Random & rng);
 
 	/**
 	* Crossover this genome with the one passed into the function.
 	* \param parent2 is the other genome we will perform the crossover with.
+	* \param rng is the random number generator to draw from.
 	* \return a pointer to the offspring.
 	*/
-	TSPGenome<T> * crossover(const Genome & parent2);
+	TSPGenome<T> * crossover(const Genome & parent2, Random & rng);
 	/**
 	* This is a type of crossover called Partially Mapped Crossover.
 	* \param parent2 is the other genome we will perform the crossover with.
+	* \param rng is the random number generator to draw from.
 	* \return a pointer to the offspring.
 	*/
-	TSPGenome<T> * partialMapcrossover(const Genome & parent2);
+	TSPGenome<T> * partialMapcrossover(const Genome & parent2, Random & rng);
 	/**
 	* This is a type of crossover called Order Based Crossover.
 	* \param parent2 is the other genome we will perform the crossover with.
+	* \param rng is the random number generator to draw from.
 	* \return a pointer to the offspring.
 	*/
-	TSPGenome<T> * orderBasedcrossover(const Genome & parent2);
+	TSPGenome<T> * orderBasedcrossover(const Genome & parent2, Random & rng);
 	
 
 	/**
 	* Mutate this TSPGenome. This will switch something in the list with another randomly.
+	* \param rng is the random number generator to draw from.
 	*/
-	void mutate();
+	void mutate(Random & rng);
 
 	/**
 	* This function will test to see if the given city number is in the vector already.
@@ -243,7 +256,7 @@ Genome * TSPGenome<T>::clone()
 }
 
 template <typename T>
-TSPGenome<T> * TSPGenome<T>::premuteClone()
+TSPGenome<T> * TSPGenome<T>::premuteClone(Random & rng)
 {
 	TSPGenome<T> *new_genome = new TSPGenome<T>();
 	new_genome->Genome::copy(*this);
@@ -253,10 +266,10 @@ TSPGenome<T> * TSPGenome<T>::premuteClone()
 	for(int i = 0; i < (int)new_genome->genome_vec->size(); ++i)
 	{
 		// get two random indexs less than 20;
-		int rand_index_1 = rand() % ((int)new_genome->genome_vec->size() - 1);
-		int rand_index_2 = rand() % ((int)new_genome->genome_vec->size() - 1);
+		int rand_index_1 = rng.randomInt((int)new_genome->genome_vec->size() - 1);
+		int rand_index_2 = rng.randomInt((int)new_genome->genome_vec->size() - 1);
 		while(rand_index_1 == rand_index_2)
-			rand_index_2 = rand() % ((int)new_genome->genome_vec->size() - 1);
+			rand_index_2 = rng.randomInt((int)new_genome->genome_vec->size() - 1);
 
 		new_genome->swap(rand_index_1, rand_index_2);
 	}
@@ -276,6 +289,27 @@ void TSPGenome<T>::copy(const TSPGenome<T> & orig)
 	}
 }
 
+template <typename T>
+void TSPGenome<T>::copy(const Genome & orig)
+{
+	const TSPGenome<T> & other = dynamic_cast<const TSPGenome<T> &>(orig);
+	Genome::copy(orig);
+
+	while(genome_vec->size() > other.genome_vec->size())
+	{
+		delete genome_vec->back();
+		genome_vec->pop_back();
+	}
+	for(size_t i = 0; i < other.genome_vec->size(); ++i)
+	{
+		T city = (*other.genome_vec)[i];
+		if(i < genome_vec->size())
+			(*genome_vec)[i]->setCoordinates(city->getX(), city->getY(), city->getZ());
+		else
+			genome_vec->push_back(new City(city->getX(), city->getY(), city->getZ()));
+	}
+	num_citys = other.num_citys;
+}
 
 template <typename T>
 void TSPGenome<T>::evaluate()
@@ -306,38 +340,38 @@ void TSPGenome<T>::evaluate()
 }
 
 template <typename T>
-void TSPGenome<T>::initialize()
+void TSPGenome<T>::initialize(Random & rng)
 {
 	for(int i = 0; i < num_citys; ++i)
 	{
-		genome_vec->push_back(new City());
+		genome_vec->push_back(new City(rng));
 	}
 }
 
 template <typename T>
-void TSPGenome<T>::mutate()
+void TSPGenome<T>::mutate(Random & rng)
 {
 	// choose two numbers in the list
-	int pos1 = rand() % ((int)genome_vec->size() -1);
+	int pos1 = rng.randomInt((int)genome_vec->size() -1);
 	int pos2 = pos1;
 	
 	// make sure pos1 and pos2 and not the same
 	while(pos1 == pos2)
-		pos2 = rand() % ((int)genome_vec->size() -1);
+		pos2 = rng.randomInt((int)genome_vec->size() -1);
 
-	// swaps the elements in the vector
+	// swaps the elements in the vector (this marks the score out of date)
 	swap(pos1, pos2);
 }
 
 template <typename T>
-TSPGenome<T> * TSPGenome<T>::crossover(const Genome & parent2)
+TSPGenome<T> * TSPGenome<T>::crossover(const Genome & parent2, Random & rng)
 {
-		return partialMapcrossover(parent2);
-		//return orderBasedcrossover(parent2);
+		return partialMapcrossover(parent2, rng);
+		//return orderBasedcrossover(parent2, rng);
 }
 
 template <typename T>
-TSPGenome<T> * TSPGenome<T>::partialMapcrossover(const Genome & parent2)
+TSPGenome<T> * TSPGenome<T>::partialMapcrossover(const Genome & parent2, Random & rng)
 {
 	const TSPGenome<T> & p2 = (dynamic_cast<const TSPGenome<T> &>(parent2));
 	//Genome * child = new TSPGenome<T>();
@@ -349,8 +383,8 @@ TSPGenome<T> * TSPGenome<T>::partialMapcrossover(const Genome & parent2)
 	if(*this == p2)
 		return child;
 
-	int begin = rand() % ((int)genome_vec->size() -1);
-	int end = rand() % ((int)genome_vec->size() -1);
+	int begin = rng.randomInt((int)genome_vec->size() -1);
+	int end = rng.randomInt((int)genome_vec->size() -1);
 	// now lets interate through the matched pairs of genes from begin
 	// to end swapping the places in each child
 	for(int pos = begin; pos < end + 1; ++pos)
@@ -373,7 +407,7 @@ TSPGenome<T> * TSPGenome<T>::partialMapcrossover(const Genome & parent2)
 }
 
 template <typename T>
-TSPGenome<T> * TSPGenome<T>::orderBasedcrossover(const Genome & parent2)
+TSPGenome<T> * TSPGenome<T>::orderBasedcrossover(const Genome & parent2, Random & rng)
 {
 	const TSPGenome<T> & p2 = (dynamic_cast<const TSPGenome<T> &>(parent2));
 	//Genome * child = new TSPGenome<T>();
@@ -388,7 +422,7 @@ TSPGenome<T> * TSPGenome<T>::orderBasedcrossover(const Genome & parent2)
 	std::vector<T> temp_cities;
 	std::vector<int> positions;
 
-	int pos = rand() % ((int)genome_vec->size() - 2);
+	int pos = rng.randomInt((int)genome_vec->size() - 2);
 	// keep adding random cities until we can add no more.
 	// keep the positions as we go.
 	while(pos < (int)genome_vec->size())
@@ -396,7 +430,7 @@ TSPGenome<T> * TSPGenome<T>::orderBasedcrossover(const Genome & parent2)
 		positions.push_back(pos);
 		temp_cities.push_back((*genome_vec)[pos]);
 		// next city
-		pos += 1 + (rand() % ((int)genome_vec->size() - pos));
+		pos += 1 + rng.randomInt((int)genome_vec->size() - pos);
 	}
 
 	int c_pos = 0;
@@ -412,6 +446,7 @@ TSPGenome<T> * TSPGenome<T>::orderBasedcrossover(const Genome & parent2)
 			}
 		}
 	}
+	child->invalidateScore();
 	return child;
 }
 
@@ -456,9 +491,11 @@ bool TSPGenome<T>::CheckForCity(int city_num)
 template <typename T>
 double TSPGenome<T>::DistanceBetweenCitys(T c1, T c2)
 {
-	return sqrt(pow(((double)c2->getX() - (double)c1->getX()), 2) + 
-				pow(((double)c2->getY() - (double)c1->getY()), 2) + 
-		        pow(((double)c2->getZ() - (double)c1->getZ()), 2));
+	double dx = (double)c2->getX() - (double)c1->getX();
+	double dy = (double)c2->getY() - (double)c1->getY();
+	double dz = (double)c2->getZ() - (double)c1->getZ();
+
+	return sqrt(dx*dx + dy*dy + dz*dz);
 }
 
 template <typename T>
@@ -475,6 +512,7 @@ void TSPGenome<T>::swap(int pos1, int pos2)
 	T tmp = (*genome_vec)[pos1];
 	(*genome_vec)[pos1] = (*genome_vec)[pos2];
 	(*genome_vec)[pos2] = tmp;
+	invalidateScore();
 }
 
 template <typename T>
@@ -0,0 +1,507 @@
+#include <iostream>
+#include <cstring>
+
+#include "TSPIndexGenome.h"
+#include "CityTable.h"
+#include "Random.h"
+
+using namespace std;
+
+TSPIndexGenome::TSPIndexGenome()
+	: Genome(), city_table(0), crossover_type(TSP_CROSSOVER)
+{
+
+}
+
+TSPIndexGenome::TSPIndexGenome(const CityTable * table)
+	: Genome(), city_table(table), crossover_type(TSP_CROSSOVER)
+{
+
+}
+
+TSPIndexGenome::TSPIndexGenome(const TSPIndexGenome & other)
+	: Genome(other), city_table(other.city_table), tour(other.tour), position(other.position),
+	  crossover_type(other.crossover_type)
+{
+
+}
+
+TSPIndexGenome::~TSPIndexGenome()
+{
+
+}
+
+Genome * TSPIndexGenome::clone()
+{
+	return new TSPIndexGenome(*this);
+}
+
+TSPIndexGenome * TSPIndexGenome::premuteClone(Random & rng)
+{
+	TSPIndexGenome *new_genome = new TSPIndexGenome(*this);
+
+	// now premute the cities (Fisher-Yates shuffle)
+	for(int i = (int)new_genome->tour.size() - 1; i > 0; --i)
+	{
+		new_genome->swap(i, rng.randomInt(i + 1));
+	}
+
+	return new_genome;
+}
+
+void TSPIndexGenome::copy(const Genome & orig)
+{
+	copy(dynamic_cast<const TSPIndexGenome &>(orig));
+}
+
+void TSPIndexGenome::copy(const TSPIndexGenome & orig)
+{
+	Genome::copy(orig);
+	city_table = orig.city_table;
+	tour = orig.tour;
+	position = orig.position;
+	crossover_type = orig.crossover_type;
+}
+
+void TSPIndexGenome::evaluate()
+{
+	if(isEvaluated())
+		return;
+
+	int num_cities = (int)tour.size();
+
+	if(num_cities < 2)
+	{
+		setScore(0.0);
+		return;
+	}
+
+	double total = 0.0; // accumulate distances
+	for(int i = 0; i < num_cities - 1; ++i)
+		total += city_table->distance(tour[i], tour[i + 1]);
+
+	// don't forget the length from the last city to the first city
+	total += city_table->distance(tour[num_cities - 1], tour[0]);
+
+	setScore(total);
+}
+
+void TSPIndexGenome::initialize(Random &)
+{
+	tour.resize(city_table->getNumCities());
+	position.resize(tour.size());
+	for(int i = 0; i < (int)tour.size(); ++i)
+	{
+		tour[i] = i;
+		position[i] = i;
+	}
+	invalidateScore();
+}
+
+void TSPIndexGenome::mutate(Random & rng)
+{
+	if(tour.size() < 2)
+		return;
+
+	// choose two positions in the tour
+	int pos1 = rng.randomInt((int)tour.size());
+	int pos2 = pos1;
+
+	// make sure pos1 and pos2 are not the same
+	while(pos1 == pos2)
+		pos2 = rng.randomInt((int)tour.size());
+
+	swapAndUpdateScore(pos1, pos2);
+}
+
+TSPIndexGenome * TSPIndexGenome::crossover(const Genome & parent2, Random & rng)
+{
+	TSPIndexGenome *child = new TSPIndexGenome(city_table);
+	crossover(parent2, *child, rng);
+	return child;
+}
+
+void TSPIndexGenome::crossover(const Genome & parent2, Genome & child, Random & rng)
+{
+	TSPIndexGenome & c = dynamic_cast<TSPIndexGenome &>(child);
+
+	if(crossover_type == ORDER_CROSSOVER)
+		orderCrossover(parent2, c, rng);
+	else if(crossover_type == ORDER_BASED)
+		orderBasedcrossover(parent2, c, rng);
+	else // if(crossover_type == PARTIAL_MAPPED)
+		partialMapcrossover(parent2, c, rng);
+}
+
+TSPIndexGenome * TSPIndexGenome::partialMapcrossover(const Genome & parent2, Random & rng)
+{
+	TSPIndexGenome *child = new TSPIndexGenome(city_table);
+	partialMapcrossover(parent2, *child, rng);
+	return child;
+}
+
+TSPIndexGenome * TSPIndexGenome::orderCrossover(const Genome & parent2, Random & rng)
+{
+	TSPIndexGenome *child = new TSPIndexGenome(city_table);
+	orderCrossover(parent2, *child, rng);
+	return child;
+}
+
+TSPIndexGenome * TSPIndexGenome::orderBasedcrossover(const Genome & parent2, Random & rng)
+{
+	TSPIndexGenome *child = new TSPIndexGenome(city_table);
+	orderBasedcrossover(parent2, *child, rng);
+	return child;
+}
+
+void TSPIndexGenome::partialMapcrossover(const Genome & parent2, TSPIndexGenome & child, Random & rng)
+{
+	const TSPIndexGenome & p2 = dynamic_cast<const TSPIndexGenome &>(parent2);
+
+	child.copy(*this);
+
+	// do not want them to be the same genomes
+	if(*this == p2)
+		return;
+
+	int begin = rng.randomInt((int)tour.size());
+	int end = rng.randomInt((int)tour.size());
+	if(begin > end)
+	{
+		int tmp = begin;
+		begin = end;
+		end = tmp;
+	}
+
+	// now lets interate through the matched pairs of genes from begin
+	// to end swapping the places in the child. The position index makes
+	// each lookup constant time, so this is linear in the segment length.
+	for(int pos = begin; pos < end + 1; ++pos)
+	{
+		int gene1 = tour[pos];
+		int gene2 = p2.tour[pos];
+
+		if(gene1 != gene2)
+			child.swap(child.GetIndex(gene1), child.GetIndex(gene2));
+	}
+}
+
+void TSPIndexGenome::orderCrossover(const Genome & parent2, TSPIndexGenome & child, Random & rng)
+{
+	const TSPIndexGenome & p2 = dynamic_cast<const TSPIndexGenome &>(parent2);
+
+	child.copy(*this);
+
+	// do not want them to be the same genomes
+	if(*this == p2)
+		return;
+
+	int num_cities = (int)tour.size();
+	child.invalidateScore();
+
+	int begin = rng.randomInt(num_cities);
+	int end = rng.randomInt(num_cities);
+	if(begin > end)
+	{
+		int tmp = begin;
+		begin = end;
+		end = tmp;
+	}
+
+	// the child's position index doubles as the membership bitmap: -1 means the
+	// city has not been placed yet. The segment from this genome is already in place.
+	for(int i = 0; i < num_cities; ++i)
+		child.position[i] = -1;
+	for(int pos = begin; pos < end + 1; ++pos)
+		child.position[tour[pos]] = pos;
+
+	// fill the rest of the child with parent2's cities in the order they come after
+	// the segment, skipping the ones already placed
+	int fill = (end + 1 == num_cities) ? 0 : end + 1;
+	int from = fill;
+	while(fill != begin)
+	{
+		int city = p2.tour[from];
+		if(child.position[city] == -1)
+		{
+			child.tour[fill] = city;
+			child.position[city] = fill;
+			fill = (fill + 1 == num_cities) ? 0 : fill + 1;
+		}
+		from = (from + 1 == num_cities) ? 0 : from + 1;
+	}
+}
+
+void TSPIndexGenome::orderBasedcrossover(const Genome & parent2, TSPIndexGenome & child, Random & rng)
+{
+	const TSPIndexGenome & p2 = dynamic_cast<const TSPIndexGenome &>(parent2);
+
+	child.copy(p2);
+
+	// do not want them to be the same genomes
+	if(*this == p2 || tour.size() < 3)
+		return;
+
+	int num_cities = (int)tour.size();
+	child.invalidateScore();
+
+	// select random cities from this genome. A selected city is marked in the child by
+	// flipping its position (so it stays recoverable) and the slot holding it is marked
+	// by flipping the city. No extra buffers are needed.
+	int pos = rng.randomInt(num_cities - 2);
+	while(pos < num_cities)
+	{
+		int city = tour[pos];
+		int slot = child.position[city];
+		child.position[city] = ~slot;
+		child.tour[slot] = ~city;
+		// next city
+		pos += 1 + rng.randomInt(num_cities - pos);
+	}
+
+	// the marked slots of the child, left to right, get the selected cities
+	// in the order they appear in this genome
+	int slot = 0;
+	for(int i = 0; i < num_cities; ++i)
+	{
+		int city = tour[i];
+		if(child.position[city] >= 0)
+			continue;
+
+		while(child.tour[slot] >= 0)
+			++slot;
+		child.tour[slot] = city;
+	}
+
+	child.rebuildPositions();
+}
+
+double TSPIndexGenome::distance(const Genome & other) const
+{
+	const TSPIndexGenome & o = dynamic_cast<const TSPIndexGenome &>(other);
+
+	int num_cities = (int)tour.size();
+	if(num_cities < 2 || (int)o.tour.size() != num_cities)
+		return (num_cities == (int)o.tour.size()) ? 0.0 : 1.0;
+
+	// an edge is shared if the next city here is next to the same city in the other tour
+	int missing = 0;
+	for(int i = 0; i < num_cities; ++i)
+	{
+		int city = tour[i];
+		int next = tour[(i + 1 == num_cities) ? 0 : i + 1];
+		int pos = o.position[city];
+		int after = o.tour[(pos + 1 == num_cities) ? 0 : pos + 1];
+		int before = o.tour[(pos == 0) ? num_cities - 1 : pos - 1];
+		if(next != after && next != before)
+			++missing;
+	}
+	return (double)missing / num_cities;
+}
+
+unsigned int TSPIndexGenome::packedSize() const
+{
+	unsigned int city_bytes = (tour.size() <= 65536) ? 2 : 4;
+	return (unsigned int)(sizeof(double) + sizeof(int) + tour.size() * city_bytes);
+}
+
+void TSPIndexGenome::pack(char *buffer) const
+{
+	double score = getScore();
+	int num_cities = (int)tour.size();
+	memcpy(buffer, &score, sizeof(double));
+	buffer += sizeof(double);
+	memcpy(buffer, &num_cities, sizeof(int));
+	buffer += sizeof(int);
+
+	if(num_cities <= 65536)
+	{
+		for(int i = 0; i < num_cities; ++i, buffer += 2)
+		{
+			unsigned short city = (unsigned short)tour[i];
+			memcpy(buffer, &city, 2);
+		}
+	}
+	else
+		memcpy(buffer, &tour[0], num_cities * sizeof(int));
+}
+
+bool TSPIndexGenome::unpack(const char *buffer, unsigned int size)
+{
+	double score;
+	int num_cities;
+
+	if(size < sizeof(double) + sizeof(int))
+		return false;
+	memcpy(&score, buffer, sizeof(double));
+	buffer += sizeof(double);
+	memcpy(&num_cities, buffer, sizeof(int));
+	buffer += sizeof(int);
+
+	if(!city_table || num_cities != city_table->getNumCities())
+		return false;
+
+	// check the whole message is there before anything is changed
+	bool short_cities = (num_cities <= 65536);
+	unsigned long city_size = short_cities ? 2 : sizeof(int);
+	if(size < sizeof(double) + sizeof(int) + (unsigned long)num_cities * city_size)
+		return false;
+
+	tour.resize(num_cities);
+	if(short_cities)
+	{
+		for(int i = 0; i < num_cities; ++i, buffer += 2)
+		{
+			unsigned short city;
+			memcpy(&city, buffer, 2);
+			tour[i] = city;
+		}
+	}
+	else
+		memcpy(&tour[0], buffer, num_cities * sizeof(int));
+
+	// make sure every city is there exactly once before trusting the tour
+	position.assign(num_cities, -1);
+	for(int i = 0; i < num_cities; ++i)
+	{
+		if(tour[i] < 0 || tour[i] >= num_cities || position[tour[i]] != -1)
+		{
+			// leave a valid tour behind
+			for(int j = 0; j < num_cities; ++j)
+			{
+				tour[j] = j;
+				position[j] = j;
+			}
+			invalidateScore();
+			return false;
+		}
+		position[tour[i]] = i;
+	}
+
+	setScore(score);
+	return true;
+}
+
+void TSPIndexGenome::setCrossoverType(int type)
+{
+	crossover_type = type;
+}
+
+int TSPIndexGenome::getCrossoverType() const
+{
+	return crossover_type;
+}
+
+bool TSPIndexGenome::CheckForCity(int city_num) const
+{
+	return city_num >= 0 && city_num < (int)position.size() && tour[position[city_num]] == city_num;
+}
+
+int TSPIndexGenome::GetIndex(int city_num) const
+{
+	if(!CheckForCity(city_num))
+		return (int)tour.size(); // it was not found so it will return the number of cities
+
+	return position[city_num];
+}
+
+void TSPIndexGenome::swap(int pos1, int pos2)
+{
+	int tmp = tour[pos1];
+	tour[pos1] = tour[pos2];
+	tour[pos2] = tmp;
+	position[tour[pos1]] = pos1;
+	position[tour[pos2]] = pos2;
+	invalidateScore();
+}
+
+void TSPIndexGenome::swapAndUpdateScore(int pos1, int pos2)
+{
+	if(!isEvaluated())
+	{
+		swap(pos1, pos2);
+		return;
+	}
+
+	double before = edgesAround(pos1, pos2);
+
+	int tmp = tour[pos1];
+	tour[pos1] = tour[pos2];
+	tour[pos2] = tmp;
+	position[tour[pos1]] = pos1;
+	position[tour[pos2]] = pos2;
+
+	setScore(getScore() - before + edgesAround(pos1, pos2));
+}
+
+double TSPIndexGenome::edgesAround(int pos1, int pos2) const
+{
+	int num_cities = (int)tour.size();
+
+	// edge k goes from position k to position k + 1, wrapping back to the first city
+	int edges[4];
+	edges[0] = (pos1 == 0) ? num_cities - 1 : pos1 - 1;
+	edges[1] = pos1;
+	edges[2] = (pos2 == 0) ? num_cities - 1 : pos2 - 1;
+	edges[3] = pos2;
+
+	double total = 0.0;
+	for(int i = 0; i < 4; ++i)
+	{
+		// adjacent positions share an edge, only count it once
+		bool counted = false;
+		for(int j = 0; j < i; ++j)
+		{
+			if(edges[j] == edges[i])
+				counted = true;
+		}
+		if(counted)
+			continue;
+
+		int next = (edges[i] + 1 == num_cities) ? 0 : edges[i] + 1;
+		total += city_table->distance(tour[edges[i]], tour[next]);
+	}
+	return total;
+}
+
+void TSPIndexGenome::rebuildPositions()
+{
+	position.resize(tour.size());
+	for(int i = 0; i < (int)tour.size(); ++i)
+	{
+		position[tour[i]] = i;
+	}
+}
+
+int TSPIndexGenome::getCity(int pos) const
+{
+	return tour[pos];
+}
+
+int TSPIndexGenome::getNumCities() const
+{
+	return (int)tour.size();
+}
+
+const CityTable * TSPIndexGenome::getCityTable() const
+{
+	return city_table;
+}
+
+TSPIndexGenome & TSPIndexGenome::operator=(const TSPIndexGenome & other)
+{
+	if(this != &other)
+		copy(other);
+
+	return *this;
+}
+
+bool operator==(const TSPIndexGenome & t1, const TSPIndexGenome & t2)
+{
+	return t1.tour == t2.tour;
+}
+
+bool operator!=(const TSPIndexGenome & t1, const TSPIndexGenome & t2)
+{
+	return !(t1 == t2);
+}
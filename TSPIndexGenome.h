@@ -0,0 +1,284 @@
+#ifndef TSPINDEXGENOME_H
+#define TSPINDEXGENOME_H
+
+/**
+ * \file TSPIndexGenome.h
+ */
+
+#include "Genome.h"
+#include "config.h"
+#include <vector>
+
+class CityTable;
+class Random;
+
+/**
+ * This is a representation of a travelling sales person problem as a genome.
+ * Unlike TSPGenome<City *> it does not own any cities. The cities live once in a
+ * CityTable shared by the whole population and the genome is only a permutation
+ * of city indexes held in one flat buffer, so copying a tour is a single memcpy.
+ */
+class TSPIndexGenome : public Genome
+{
+public:
+	/**
+	 * Default constructor. The genome has no cities until it is given a table.
+	 */
+	TSPIndexGenome();
+	/**
+	 * Overloaded constructor.
+	 * \param table is the city table this genome will tour. It is not owned by the genome.
+	 */
+	TSPIndexGenome(const CityTable * table);
+	/**
+	 * Copy constructor.
+	 * \param other is the other TSPIndexGenome.
+	 */
+	TSPIndexGenome(const TSPIndexGenome & other);
+	/**
+	 * Destructor.
+	 */
+	~TSPIndexGenome();
+
+	/**
+	 * Clones a genome of type TSPIndexGenome.
+	 * \return a pointer to a Genome object.
+	 */
+	Genome * clone();
+	/**
+	 * Clones a genome of type TSPIndexGenome. But premutes the cities of the genome it's cloning.
+	 * \param rng is the random number generator to draw from.
+	 * \return a pointer to a TSPIndexGenome object.
+	 */
+	TSPIndexGenome * premuteClone(Random & rng);
+	/**
+	 * Copies the content of a genome. The tour reuses this genome's storage, so copying a
+	 * tour of the same size does not allocate.
+	 * \param orig is the original genome to copy from. It must be a TSPIndexGenome.
+	 */
+	void copy(const Genome & orig);
+	/**
+	 * Copies the content of a genome.
+	 * \param orig is the original genome to copy from.
+	 */
+	void copy(const TSPIndexGenome & orig);
+
+	/**
+	 * Evaluate this genome. It will set the score to the length of the tour.
+	 * Nothing is done if the score is already up to date with the tour.
+	 */
+	void evaluate();
+	/**
+	 * Initialize the genome. The tour will visit every city of the table in order.
+	 * \param rng is not used, the tour is always the same.
+	 */
+	void initialize(Random & rng);
+	/**
+	 * Mutate this genome. This will swap two cities in the tour. If the genome was already
+	 * evaluated its score is updated from the edges that changed instead of re-evaluated.
+	 * \param rng is the random number generator to draw from.
+	 */
+	void mutate(Random & rng);
+
+	/**
+	 * Crossover this genome with the one passed into the function.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param rng is the random number generator to draw from.
+	 * \return a pointer to the offspring.
+	 */
+	TSPIndexGenome * crossover(const Genome & parent2, Random & rng);
+	/**
+	 * Crossover this genome with the one passed into the function, writing the offspring
+	 * over an existing genome instead of allocating a new one.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param child is the genome to overwrite. It must be a TSPIndexGenome and not a parent.
+	 * \param rng is the random number generator to draw from.
+	 */
+	void crossover(const Genome & parent2, Genome & child, Random & rng);
+	/**
+	 * This is a type of crossover called Partially Mapped Crossover.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param rng is the random number generator to draw from.
+	 * \return a pointer to the offspring.
+	 */
+	TSPIndexGenome * partialMapcrossover(const Genome & parent2, Random & rng);
+	/**
+	 * The same crossover, writing the offspring over an existing genome.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param child is the genome to overwrite. It must not be a parent.
+	 * \param rng is the random number generator to draw from.
+	 */
+	void partialMapcrossover(const Genome & parent2, TSPIndexGenome & child, Random & rng);
+	/**
+	 * This is a type of crossover called Order Crossover (OX). A random segment is
+	 * copied from this genome and the rest is filled with parent2's cities in order.
+	 * This is linear in the number of cities.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param rng is the random number generator to draw from.
+	 * \return a pointer to the offspring.
+	 */
+	TSPIndexGenome * orderCrossover(const Genome & parent2, Random & rng);
+	/**
+	 * The same crossover, writing the offspring over an existing genome.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param child is the genome to overwrite. It must not be a parent.
+	 * \param rng is the random number generator to draw from.
+	 */
+	void orderCrossover(const Genome & parent2, TSPIndexGenome & child, Random & rng);
+	/**
+	 * This is a type of crossover called Order Based Crossover (OX2). Random cities are
+	 * selected from this genome and put into a copy of parent2, in this genome's order.
+	 * This is linear in the number of cities.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param rng is the random number generator to draw from.
+	 * \return a pointer to the offspring.
+	 */
+	TSPIndexGenome * orderBasedcrossover(const Genome & parent2, Random & rng);
+	/**
+	 * The same crossover, writing the offspring over an existing genome.
+	 * \param parent2 is the other genome we will perform the crossover with.
+	 * \param child is the genome to overwrite. It must not be a parent.
+	 * \param rng is the random number generator to draw from.
+	 */
+	void orderBasedcrossover(const Genome & parent2, TSPIndexGenome & child, Random & rng);
+
+	/**
+	 * Measures how different two tours are by the edges they share. This is linear in the
+	 * number of cities thanks to the position index of the other tour.
+	 * \param other is the genome to compare with. It must be a TSPIndexGenome.
+	 * \return the fraction of this tour's edges, in either direction, that other does not have.
+	 */
+	double distance(const Genome & other) const;
+
+	/**
+	 * Gets the number of bytes pack() writes: the score, the number of cities and the tour,
+	 * with two bytes a city when there are no more than 65536 cities and four otherwise.
+	 * \return the number of bytes.
+	 */
+	unsigned int packedSize() const;
+	/**
+	 * Writes the score and the tour into a flat buffer, so it can be sent to another process.
+	 * \param buffer is where to write, at least packedSize() bytes.
+	 */
+	void pack(char *buffer) const;
+	/**
+	 * Reads a tour written by pack() into this genome. The genome keeps its city table, so the
+	 * tour must have come from a genome touring the same cities.
+	 * \param buffer is where to read from.
+	 * \param size is the number of bytes in buffer.
+	 * \return true if buffer held a whole tour of this genome's table.
+	 */
+	bool unpack(const char *buffer, unsigned int size);
+
+	/**
+	 * Sets the crossover used by crossover(). Clones inherit it.
+	 * \param type is PARTIAL_MAPPED, ORDER_CROSSOVER or ORDER_BASED.
+	 */
+	void setCrossoverType(int type);
+	/**
+	 * Gets the crossover used by crossover().
+	 * \return PARTIAL_MAPPED, ORDER_CROSSOVER or ORDER_BASED.
+	 */
+	int getCrossoverType() const;
+
+	/**
+	 * This function will test to see if the given city is in the tour. This is constant time.
+	 * \param city_num is the index of the city in the table.
+	 * \return true or false depending on if the city is found or not.
+	 */
+	bool CheckForCity(int city_num) const;
+	/**
+	 * This function will get the position of the given city in the tour. This is a lookup
+	 * in the position index, not a search.
+	 * \param city_num is the index of the city in the table.
+	 * \return the position, or the number of cities if it was not found.
+	 */
+	int GetIndex(int city_num) const;
+	/**
+	 * Swaps the city in one position with the city in another position of the tour.
+	 * The genome will need to be evaluated again.
+	 * \param pos1 is the first position.
+	 * \param pos2 is the second position.
+	 */
+	void swap(int pos1, int pos2);
+	/**
+	 * Swaps two positions and keeps the score up to date by subtracting the old edges
+	 * around the two positions and adding the new ones, at most four each.
+	 * \param pos1 is the first position.
+	 * \param pos2 is the second position.
+	 */
+	void swapAndUpdateScore(int pos1, int pos2);
+
+	/**
+	 * Gets the city at a position in the tour.
+	 * \param pos is the position in the tour.
+	 * \return the index of the city in the table.
+	 */
+	int getCity(int pos) const;
+	/**
+	 * Gets the number of cities in the tour.
+	 * \return the number of cities.
+	 */
+	int getNumCities() const;
+	/**
+	 * Gets the table this genome is touring.
+	 * \return a pointer to the city table.
+	 */
+	const CityTable * getCityTable() const;
+
+	/**
+	 * Assignment operator for a TSPIndexGenome.
+	 * \param other is the TSPIndexGenome it wants to be equal to.
+	 * \return a reference to this genome.
+	 */
+	TSPIndexGenome & operator=(const TSPIndexGenome & other);
+
+	/**
+	 * Comparison operator for a TSPIndexGenome.
+	 * \param t1 is a TSPIndexGenome to compare
+	 * \param t2 is a TSPIndexGenome to compare
+	 * \return true if they visit the same cities in the same order.
+	 */
+	friend bool operator==(const TSPIndexGenome & t1, const TSPIndexGenome & t2);
+	/**
+	 * Comparison operator for a TSPIndexGenome.
+	 * \param t1 is a TSPIndexGenome to compare
+	 * \param t2 is a TSPIndexGenome to compare
+	 * \return true if they are not equal and false otherwise.
+	 */
+	friend bool operator!=(const TSPIndexGenome & t1, const TSPIndexGenome & t2);
+
+private:
+	/**
+	 * Gets the total length of the edges that leave the given positions. Each edge is only
+	 * counted once even if two positions are next to each other.
+	 * \param pos1 is the first position.
+	 * \param pos2 is the second position.
+	 * \return the length of the edges touching pos1 and pos2.
+	 */
+	double edgesAround(int pos1, int pos2) const;
+	/**
+	 * Rebuilds the position index from the tour. Only needed after the tour
+	 * has been written to directly.
+	 */
+	void rebuildPositions();
+
+	/**
+	 * The shared city table. It is owned by whoever created it, not by the genome.
+	 */
+	const CityTable *city_table;
+	/**
+	 * The tour, as a permutation of indexes into the city table.
+	 */
+	std::vector<int> tour;
+	/**
+	 * The inverse of the tour. position[city] is the position of city in the tour.
+	 */
+	std::vector<int> position;
+	/**
+	 * The crossover used by crossover(). It defaults to TSP_CROSSOVER.
+	 */
+	int crossover_type;
+};
+
+#endif
@@ -1,40 +1,184 @@
 #include <iostream>
 #include <vector>
+#include <sstream>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include "TSPGenome.h"
+#include "TSPIndexGenome.h"
 #include "City.h"
+#include "CityTable.h"
 #include "Population.h"
 #include "SteadyStateGA.h"
+#include "IslandGA.h"
+#include "SharedMigrantRing.h"
+#include "SharedMemoryMigration.h"
+#include "Random.h"
+#include "Statistics.h"
+#include "Reporter.h"
 
 using namespace std;
 
-void InitializeTSP();
+void InitializeTSP(Random & rng);
+Population * CreatePopulation(Random & rng);
+void RunIslandProcesses(Random & rng);
+void RunIsland(const string & base_name, int island, unsigned long long seed);
 
 Population *p;
 SteadyStateGA *ssGA;
+CityTable *cities;
+Genome *tsp_genome;
 int city_size = 200;
 
-int main()
+int main(int argc, char **argv)
 {	
-	InitializeTSP();
+	// every random number of the run comes from generators seeded here
+	Random rng;
+	if(RANDOM_SEED != 0)
+		rng.seed(RANDOM_SEED);
+
+	InitializeTSP(rng);
 	
-	ssGA = new SteadyStateGA(p);
-	ssGA->evolve();	
-	delete ssGA; // population destructor called in ssGa destructor
+	if(ISLAND_PROCESSES > 1)
+	{
+		RunIslandProcesses(rng);
+	}
+	else if(NUM_ISLANDS > 1)
+	{
+		// every island gets its own population of tours of the same cities
+		IslandGA islands;
+		for(int i = 0; i < NUM_ISLANDS; ++i)
+			islands.addIsland(new SteadyStateGA(CreatePopulation(rng)));
+		islands.setSeed(rng.randomBits());
+		islands.evolve();
+		cout << islands << endl;
+	}
+	else
+	{
+		p = CreatePopulation(rng);
+		ssGA = new SteadyStateGA(p);
+		ssGA->setSeed(rng.randomBits());
+
+		// the progress is written from the reporter's thread, not the evolution loop
+		Reporter reporter;
+		ssGA->setReporter(&reporter);
+		ssGA->evolve();	
+
+		// the metrics of every generation can be saved for plotting
+		if(argc > 1)
+			ssGA->getStatistics().getHistory().saveCSV(argv[1]);
+		delete ssGA; // population destructor called in ssGa destructor
+	}
+
+	delete tsp_genome;
+	delete cities; // the genomes only referred to the table, so it goes last
 	
 	return 0;
 }
 
-void InitializeTSP()
+void InitializeTSP(Random & rng)
 {
-	p = new Population();
-	TSPGenome<City *> *g = new TSPGenome<City *>(city_size);
-	g->initialize();
-	for(int i = 0; i < POPULATION_SIZE; ++i)
+	cities = 0;
+
+	if(TSP_REPRESENTATION == CITY_INDEXES)
+	{
+		// every genome shares one table of cities and is just a permutation of indexes
+		cities = new CityTable(city_size, rng);
+		TSPIndexGenome *g = new TSPIndexGenome(cities);
+		g->initialize(rng);
+		tsp_genome = g;
+	}
+	else // if(TSP_REPRESENTATION == CITY_POINTERS)
+	{
+		TSPGenome<City *> *g = new TSPGenome<City *>(city_size);
+		g->initialize(rng);
+		tsp_genome = g;
+	}
+}
+
+Population * CreatePopulation(Random & rng)
+{
+	Population *pop = new Population();
+
+	if(TSP_REPRESENTATION == CITY_INDEXES)
+	{
+		TSPIndexGenome *g = dynamic_cast<TSPIndexGenome *>(tsp_genome);
+		for(int i = 0; i < POPULATION_SIZE; ++i)
+		{
+			pop->addGenome(g->premuteClone(rng));
+		}
+	}
+	else // if(TSP_REPRESENTATION == CITY_POINTERS)
 	{
-		TSPGenome<City *> *g_new;
-		g_new = g->premuteClone();		
-		p->addGenome(g_new);
+		TSPGenome<City *> *g = dynamic_cast<TSPGenome<City *> *>(tsp_genome);
+		for(int i = 0; i < POPULATION_SIZE; ++i)
+		{
+			TSPGenome<City *> *g_new;
+			g_new = g->premuteClone(rng);		
+			pop->addGenome(g_new);
+		}
 	}
-	delete g;
-}
\ No newline at end of file
+	return pop;
+}
+
+void RunIslandProcesses(Random & rng)
+{
+	// the rings are made before the islands start, so every island can open all of them
+	ostringstream base_name;
+	base_name << "/genalib_tsp_" << getpid();
+
+	vector<SharedMigrantRing *> rings;
+	for(int i = 0; i < ISLAND_PROCESSES; ++i)
+	{
+		rings.push_back(new SharedMigrantRing(SharedMemoryMigration::getRingName(base_name.str(), i),
+			MIGRATION_RING_SLOTS, tsp_genome->packedSize()));
+	}
+
+	vector<pid_t> islands;
+	for(int i = 0; i < ISLAND_PROCESSES; ++i)
+	{
+		unsigned long long seed = rng.randomBits();
+		pid_t pid = fork();
+		if(pid == 0)
+		{
+			RunIsland(base_name.str(), i, seed);
+			cout.flush();
+			_exit(0); // the rings belong to the parent, so leave without destroying anything
+		}
+		if(pid > 0)
+			islands.push_back(pid);
+	}
+
+	for(vector<pid_t>::iterator it = islands.begin();
+		it != islands.end();
+		++it)
+	{
+		waitpid(*it, 0, 0);
+	}
+
+	for(vector<SharedMigrantRing *>::iterator it = rings.begin();
+		it != rings.end();
+		++it)
+	{
+		delete *it;
+	}
+}
+
+void RunIsland(const string & base_name, int island, unsigned long long seed)
+{
+	Random rng(seed);
+	SteadyStateGA ga(CreatePopulation(rng));
+	ga.setSeed(rng.randomBits());
+
+	SharedMemoryMigration migration(base_name, island, ISLAND_PROCESSES, rng.randomBits());
+	ga.setMigration(&migration);
+	ga.setVerbose(false);
+	ga.evolve();
+
+	ostringstream result;
+	result << "Island " << island << " (process " << getpid() << ") Best Score: "
+		<< ga.getPopulation()->getBestGenome().getScore() << endl;
+	cout << result.str();
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <cmath>
+
+#include "Termination.h"
+#include "Statistics.h"
+#include "MetricHistory.h"
+
+using namespace std;
+
+Termination::Termination()
+{
+	clear();
+	max_generations = total_generations;
+	if(TERMINATE_CONDITION == UPON_CONVERGENCE)
+		stagnation_limit = STAGNATION_GENERATIONS;
+}
+
+void Termination::clear()
+{
+	max_generations = 0;
+	stagnation_limit = 0;
+	improvement_threshold = 0.0;
+	improvement_generations = 0;
+	diversity_limit = 0.0;
+	clearTargetScore();
+	time_limit = 0.0;
+	max_evaluations = 0;
+	reset();
+}
+
+void Termination::setMaxGenerations(unsigned int generations)
+{
+	max_generations = generations;
+}
+
+void Termination::setStagnationLimit(unsigned int generations)
+{
+	stagnation_limit = generations;
+}
+
+void Termination::setImprovementThreshold(double fraction, unsigned int generations)
+{
+	improvement_threshold = fraction;
+	improvement_generations = generations;
+}
+
+void Termination::setDiversityLimit(double diversity)
+{
+	diversity_limit = diversity;
+}
+
+void Termination::setTargetScore(double score)
+{
+	has_target_score = true;
+	target_score = score;
+}
+
+void Termination::clearTargetScore()
+{
+	has_target_score = false;
+	target_score = 0.0;
+}
+
+void Termination::setTimeLimit(double seconds)
+{
+	time_limit = seconds;
+}
+
+void Termination::setMaxEvaluations(unsigned long long evaluations)
+{
+	max_evaluations = evaluations;
+}
+
+bool Termination::isGenerationLimitMet(unsigned int generation)
+{
+	if(max_generations > 0 && generation >= max_generations)
+	{
+		reason = "generation limit reached";
+		return true;
+	}
+	return false;
+}
+
+bool Termination::isConvergenceMet(const Statistics & stats)
+{
+	const MetricHistory & history = stats.getHistory();
+	if(history.size() == 0)
+		return false;
+
+	if(stagnation_limit > 0 &&
+		stats.getGeneration() - stats.getBestGenomeGeneration() >= (int)stagnation_limit)
+	{
+		reason = "no improvement in the stagnation limit";
+		return true;
+	}
+
+	if(improvement_generations > 0 && history.size() > improvement_generations)
+	{
+		double now = history.last().best_score;
+		double before = history.get(history.size() - 1 - improvement_generations).best_score;
+		double improvement = (HIGH_LOW == LOW_IS_BEST) ? before - now : now - before;
+		// relative to the old score, unless that was 0
+		if(before != 0.0)
+			improvement /= fabs(before);
+		if(improvement < improvement_threshold)
+		{
+			reason = "improvement below the threshold";
+			return true;
+		}
+	}
+
+	if(diversity_limit > 0.0 && history.last().diversity < diversity_limit)
+	{
+		reason = "diversity below the limit";
+		return true;
+	}
+
+	return false;
+}
+
+bool Termination::isBudgetMet(const Statistics & stats)
+{
+	const MetricHistory & history = stats.getHistory();
+	if(history.size() == 0)
+		return false;
+
+	GenerationMetrics metrics = history.last();
+	if(has_target_score && isAsGood(metrics.best_score, target_score))
+	{
+		reason = "target score reached";
+		return true;
+	}
+	if(time_limit > 0.0 && metrics.wall_time >= time_limit)
+	{
+		reason = "time limit reached";
+		return true;
+	}
+	if(max_evaluations > 0 && metrics.evaluations >= max_evaluations)
+	{
+		reason = "evaluation limit reached";
+		return true;
+	}
+
+	return false;
+}
+
+void Termination::reset()
+{
+	reason = "";
+}
+
+const char * Termination::getReason() const
+{
+	return reason;
+}
+
+bool Termination::isAsGood(double s1, double s2)
+{
+	if(HIGH_LOW == LOW_IS_BEST)
+		return s1 <= s2;
+	else
+		return s1 >= s2;
+}
@@ -0,0 +1,156 @@
+#ifndef TERMINATION_H
+#define TERMINATION_H
+
+/**
+ * \file Termination.h
+ */
+
+#include "config.h"
+class Statistics;
+
+/**
+ * This class holds the rules that end a run of a GeneticAlgorithm. Any number of them can be
+ * set at once and the run ends as soon as one is met. A rule is turned off by setting it to 0,
+ * except the target score which is turned off with clearTargetScore(), and clear() turns
+ * them all off. The rules other than the generation limit are checked against the metrics
+ * the Statistics object recorded for the current population.
+ */
+class Termination
+{
+public:
+	/**
+	 * Default constructor. The run ends after total_generations, and with UPON_CONVERGENCE
+	 * also once the best genome has not improved for STAGNATION_GENERATIONS.
+	 */
+	Termination();
+
+	/**
+	 * Turns off every rule. A run will not end until a rule is set again.
+	 */
+	void clear();
+
+	/**
+	 * Sets the number of generations after which the run ends.
+	 * \param generations is the number of generations, 0 for no limit.
+	 */
+	void setMaxGenerations(unsigned int generations);
+	/**
+	 * Ends the run once the best genome ever has not improved for a number of generations.
+	 * \param generations is the number of generations, 0 for no limit.
+	 */
+	void setStagnationLimit(unsigned int generations);
+	/**
+	 * Ends the run once the best score has improved by less than a fraction of itself over a
+	 * number of generations.
+	 * \param fraction is the smallest improvement that keeps the run going, 0.001 is 0.1%.
+	 * \param generations is the number of generations it is measured over. It must be less
+	 * than METRIC_HISTORY_SIZE. 0 turns the rule off.
+	 */
+	void setImprovementThreshold(double fraction, unsigned int generations);
+	/**
+	 * Ends the run once the diversity of the population falls below a limit.
+	 * \param diversity is the limit, see Population::getDiversity(). 0 turns the rule off.
+	 */
+	void setDiversityLimit(double diversity);
+	/**
+	 * Ends the run once a genome scores as well as the target.
+	 * \param score is the target score.
+	 */
+	void setTargetScore(double score);
+	/**
+	 * Turns off the target score, leaving the other rules as they are.
+	 */
+	void clearTargetScore();
+	/**
+	 * Ends the run once it has been going for a length of time.
+	 * \param seconds is the wall time allowed, 0 for no limit.
+	 */
+	void setTimeLimit(double seconds);
+	/**
+	 * Ends the run once the genomes have been evaluated a number of times.
+	 * \param evaluations is the number of evaluations allowed, 0 for no limit.
+	 */
+	void setMaxEvaluations(unsigned long long evaluations);
+
+	/**
+	 * Checks the generation limit.
+	 * \param generation is the current generation.
+	 * \return true if the run should end.
+	 */
+	bool isGenerationLimitMet(unsigned int generation);
+	/**
+	 * Checks the rules that tell when the population has converged: the stagnation limit,
+	 * the improvement threshold and the diversity limit.
+	 * \param stats is the statistics of the run.
+	 * \return true if the run should end.
+	 */
+	bool isConvergenceMet(const Statistics & stats);
+	/**
+	 * Checks the target score, time limit and evaluation limit.
+	 * \param stats is the statistics of the run.
+	 * \return true if the run should end.
+	 */
+	bool isBudgetMet(const Statistics & stats);
+
+	/**
+	 * Forgets the rule that was met, ready for a new run.
+	 */
+	void reset();
+	/**
+	 * Gets the rule that was met.
+	 * \return a description of the rule, or an empty string if none has been met.
+	 */
+	const char * getReason() const;
+
+private:
+	/**
+	 * Checks if one score is at least as good as another, see HIGH_LOW.
+	 * \param s1 is the first score.
+	 * \param s2 is the second score.
+	 * \return true if s1 is as good as s2 or better.
+	 */
+	static bool isAsGood(double s1, double s2);
+
+	/**
+	 * The number of generations after which the run ends, 0 for no limit.
+	 */
+	unsigned int max_generations;
+	/**
+	 * The number of generations without a better genome after which the run ends, 0 for no limit.
+	 */
+	unsigned int stagnation_limit;
+	/**
+	 * The smallest relative improvement of the best score that keeps the run going.
+	 */
+	double improvement_threshold;
+	/**
+	 * The number of generations the improvement is measured over, 0 for none.
+	 */
+	unsigned int improvement_generations;
+	/**
+	 * The diversity below which the run ends, 0 for no limit.
+	 */
+	double diversity_limit;
+	/**
+	 * True if a target score has been set.
+	 */
+	bool has_target_score;
+	/**
+	 * The score at which the run ends.
+	 */
+	double target_score;
+	/**
+	 * The number of seconds after which the run ends, 0 for no limit.
+	 */
+	double time_limit;
+	/**
+	 * The number of evaluations after which the run ends, 0 for no limit.
+	 */
+	unsigned long long max_evaluations;
+	/**
+	 * The rule that was met, empty if none.
+	 */
+	const char *reason;
+};
+
+#endif
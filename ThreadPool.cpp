@@ -0,0 +1,117 @@
+#include <iostream>
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned int num_threads)
+	: job_task(0), job_count(0), job_chunk(1), next_item(0), job_number(0), busy_workers(0), stopping(false)
+{
+	// the thread calling parallelFor() is thread 0, the workers are 1 and up
+	for(unsigned int i = 1; i < num_threads; ++i)
+	{
+		workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(job_mutex);
+		stopping = true;
+	}
+	job_ready.notify_all();
+
+	for(vector<thread>::iterator it = workers.begin();
+		it != workers.end();
+		++it)
+	{
+		it->join();
+	}
+}
+
+unsigned int ThreadPool::getNumThreads() const
+{
+	return (unsigned int)workers.size() + 1;
+}
+
+void ThreadPool::parallelFor(ParallelTask & task, int count, int chunk_size)
+{
+	if(count <= 0)
+		return;
+
+	if(chunk_size <= 0)
+	{
+		// several chunks per thread so a slow item does not hold the others up
+		chunk_size = count / (int)(getNumThreads() * 8);
+		if(chunk_size < 1)
+			chunk_size = 1;
+	}
+
+	// nothing to share, do it here
+	if(workers.empty() || count <= chunk_size)
+	{
+		task.run(0, count, 0);
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(job_mutex);
+		job_task = &task;
+		job_count = count;
+		job_chunk = chunk_size;
+		next_item.store(0);
+		busy_workers = (unsigned int)workers.size();
+		++job_number;
+	}
+	job_ready.notify_all();
+
+	runChunks(0);
+
+	// the job is not finished until every worker has stopped touching it
+	unique_lock<mutex> lock(job_mutex);
+	while(busy_workers > 0)
+		job_done.wait(lock);
+	job_task = 0;
+}
+
+void ThreadPool::workerLoop(unsigned int thread)
+{
+	unsigned long last_job = 0;
+
+	for(;;)
+	{
+		{
+			unique_lock<mutex> lock(job_mutex);
+			while(!stopping && job_number == last_job)
+				job_ready.wait(lock);
+
+			if(stopping)
+				return;
+			last_job = job_number;
+		}
+
+		runChunks(thread);
+
+		bool last_one;
+		{
+			lock_guard<mutex> lock(job_mutex);
+			last_one = (--busy_workers == 0);
+		}
+		if(last_one)
+			job_done.notify_one();
+	}
+}
+
+void ThreadPool::runChunks(unsigned int thread)
+{
+	for(;;)
+	{
+		int begin = next_item.fetch_add(job_chunk);
+		if(begin >= job_count)
+			return;
+
+		int end = (begin + job_chunk < job_count) ? begin + job_chunk : job_count;
+		job_task->run(begin, end, thread);
+	}
+}
@@ -0,0 +1,136 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/**
+ * \file ThreadPool.h
+ */
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/**
+ * This is an Abstract Data Type. It is a piece of work that a ThreadPool splits into ranges.
+ */
+class ParallelTask
+{
+public:
+	/**
+	 * Destructor.
+	 */
+	virtual ~ParallelTask() {}
+
+	/**
+	 * Does the work for the items from begin up to (not including) end.
+	 * It is called from several threads at once, with ranges that do not overlap.
+	 * \param begin is the first item.
+	 * \param end is one past the last item.
+	 * \param thread is the index of the calling thread, from 0 to the number of threads - 1.
+	 */
+	virtual void run(int begin, int end, unsigned int thread) = 0;
+};
+
+/**
+ * This class is a pool of worker threads that live as long as the pool does.
+ * Work is handed out in chunks from a shared counter, so a thread that finishes
+ * its chunk early just takes the next one.
+ */
+class ThreadPool
+{
+public:
+	/**
+	 * Overloaded constructor.
+	 * \param num_threads is the number of threads to run the work on, including the thread
+	 * that calls parallelFor(). num_threads - 1 workers are started.
+	 */
+	ThreadPool(unsigned int num_threads);
+	/**
+	 * Destructor. Stops and joins the workers.
+	 */
+	~ThreadPool();
+
+	/**
+	 * Gets the number of threads the work is run on.
+	 * \return the number of threads, including the calling thread.
+	 */
+	unsigned int getNumThreads() const;
+
+	/**
+	 * Runs a task over count items and waits for it to finish. The calling thread works too.
+	 * \param task is the task to run.
+	 * \param count is the number of items.
+	 * \param chunk_size is the number of items taken at a time. 0 picks one from count.
+	 */
+	void parallelFor(ParallelTask & task, int count, int chunk_size = 0);
+
+private:
+	/**
+	 * The pool cannot be copied.
+	 */
+	ThreadPool(const ThreadPool & other);
+	/**
+	 * The pool cannot be assigned.
+	 */
+	ThreadPool & operator=(const ThreadPool & other);
+
+	/**
+	 * The loop each worker runs until the pool is destroyed.
+	 * \param thread is the index of the worker.
+	 */
+	void workerLoop(unsigned int thread);
+	/**
+	 * Takes chunks of the current job until there are none left.
+	 * \param thread is the index of the calling thread.
+	 */
+	void runChunks(unsigned int thread);
+
+	/**
+	 * The worker threads.
+	 */
+	std::vector<std::thread> workers;
+	/**
+	 * Guards the job and the counters below.
+	 */
+	std::mutex job_mutex;
+	/**
+	 * Wakes the workers when there is a new job or the pool is stopping.
+	 */
+	std::condition_variable job_ready;
+	/**
+	 * Wakes the caller when every worker is done with the job.
+	 */
+	std::condition_variable job_done;
+
+	/**
+	 * The task of the current job.
+	 */
+	ParallelTask *job_task;
+	/**
+	 * The number of items in the current job.
+	 */
+	int job_count;
+	/**
+	 * The number of items taken at a time.
+	 */
+	int job_chunk;
+	/**
+	 * The next item to hand out.
+	 */
+	std::atomic<int> next_item;
+	/**
+	 * Incremented for each job so the workers can tell a new one from the last.
+	 */
+	unsigned long job_number;
+	/**
+	 * The number of workers still working on the current job.
+	 */
+	unsigned int busy_workers;
+	/**
+	 * True when the pool is being destroyed.
+	 */
+	bool stopping;
+};
+
+#endif
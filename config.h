@@ -4,6 +4,8 @@
 #define UPON_GENERATION 0
 #define UPON_CONVERGENCE 1
 #define TERMINATE_CONDITION UPON_GENERATION
+// with UPON_CONVERGENCE a run also ends once its best genome has not improved for this many generations
+#define STAGNATION_GENERATIONS 50
 
 #define NO_SCALING 0
 #define RANK 1
@@ -27,11 +29,54 @@
 #define FITNESS 1
 #define SORT_TYPE FITNESS
 
+#define CITY_POINTERS 0
+#define CITY_INDEXES 1
+#define TSP_REPRESENTATION CITY_INDEXES
+
+#define DISTANCE_MATRIX_LIMIT 1024
+
+#define PARTIAL_MAPPED 0
+#define ORDER_CROSSOVER 1
+#define ORDER_BASED 2
+#define TSP_CROSSOVER PARTIAL_MAPPED
+
 #define total_generations 200
 #define mutation_percentage 0.01
 #define crossover_percentage 0.9
 #define POPULATION_SIZE 1000
 
-#define TOURNAMENT_SIZE 500
+#define TOURNAMENT_SIZE 4
+
+#define EVALUATION_THREADS 1
+#define REPRODUCTION_THREADS 1
+// 1 makes every child draw from a stream keyed by the seed, generation and child, so a
+// seeded run gives the same populations whatever the number of threads
+#define DETERMINISTIC_REPRODUCTION 0
+
+#define RING_TOPOLOGY 0
+#define RANDOM_TOPOLOGY 1
+#define MIGRATION_TOPOLOGY RING_TOPOLOGY
+#define MIGRATION_INTERVAL 10
+#define NUM_MIGRANTS 2
+// more than 1 runs the example as that many islands, one thread each
+#define NUM_ISLANDS 1
+// more than 1 runs the example as that many islands, one process each, migrating
+// through rings of MIGRATION_RING_SLOTS genomes in shared memory
+#define ISLAND_PROCESSES 1
+#define MIGRATION_RING_SLOTS 64
+
+// the number of genomes compared with the best to measure the diversity of a population
+#define DIVERSITY_SAMPLES 32
+// the number of generations of metrics Statistics keeps, the oldest are dropped first
+#define METRIC_HISTORY_SIZE 4096
+
+// a Reporter writes every REPORT_GENERATIONS generations, and also when REPORT_INTERVAL_MS
+// have passed since the last (0 turns either off), from a queue of REPORT_QUEUE_SIZE generations
+#define REPORT_GENERATIONS 10
+#define REPORT_INTERVAL_MS 0
+#define REPORT_QUEUE_SIZE 256
+
+// the seed of the example runs, 0 seeds every generator from the system instead
+#define RANDOM_SEED 0
 
 #endif
\ No newline at end of file
@@ -0,0 +1,168 @@
+/**
+ * \file AllocationCheck.cpp
+ * Checks that a SteadyStateGA makes its generations without allocating once its genome
+ * pool has warmed up, both through nextGeneration() alone and through evolve(), which also
+ * updates the statistics and checks the termination rules every generation. operator new
+ * is replaced with one that counts the calls. It returns 0 if no generation allocated, on
+ * 1 and on 4 reproduction threads.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+
+#include "CityTable.h"
+#include "TSPIndexGenome.h"
+#include "Population.h"
+#include "SteadyStateGA.h"
+#include "Observer.h"
+#include "Termination.h"
+#include "MetricHistory.h"
+#include "Random.h"
+
+using namespace std;
+
+static atomic<long> num_allocations(0);
+
+void * operator new(size_t size)
+{
+	++num_allocations;
+	void *p = malloc(size ? size : 1);
+	if(!p)
+		throw bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+/**
+ * Counts the allocations made between the end of a warm up generation and the end of the run.
+ */
+class AllocationObserver : public Observer
+{
+public:
+	AllocationObserver(unsigned int in_warm_up) : warm_up(in_warm_up), start(0), end(0) {}
+	void onGenerationEnd(GeneticAlgorithm &, const PopulationSummary &, const GenerationMetrics & metrics)
+	{
+		if(metrics.generation == warm_up)
+			start = num_allocations.load();
+		end = num_allocations.load();
+	}
+	long getCount() const
+	{
+		return end - start;
+	}
+private:
+	unsigned int warm_up;
+	long start;
+	long end;
+};
+
+/**
+ * Makes a steady state genetic algorithm of random tours.
+ * \param table is the cities of the tours.
+ * \param threads is the number of reproduction threads.
+ * \return a pointer to the genetic algorithm, which owns its population.
+ */
+SteadyStateGA * CreateGA(CityTable & table, unsigned int threads)
+{
+	Random rng(1);
+	TSPIndexGenome genome(&table);
+	genome.initialize(rng);
+
+	Population *pop = new Population();
+	for(int i = 0; i < 1000; ++i)
+		pop->addGenome(genome.premuteClone(rng));
+
+	SteadyStateGA *ga = new SteadyStateGA(pop);
+	ga->setReproductionThreads(threads);
+	ga->setSeed(3);
+	return ga;
+}
+
+/**
+ * Runs a steady state genetic algorithm and counts the allocations of its later generations.
+ * \param threads is the number of reproduction threads.
+ * \return the number of allocations made by the counted generations.
+ */
+long CountAllocations(unsigned int threads)
+{
+	Random rng(1);
+	CityTable table(200, rng);
+	SteadyStateGA *ga = CreateGA(table, threads);
+	ga->init();
+
+	// the pool and the buffers of the genetic algorithm fill up in the first generations
+	for(int i = 0; i < 5; ++i)
+		ga->nextGeneration();
+
+	long before = num_allocations.load();
+	for(int i = 0; i < 50; ++i)
+		ga->nextGeneration();
+	long count = num_allocations.load() - before;
+
+	delete ga;
+	return count;
+}
+
+/**
+ * Runs a steady state genetic algorithm with evolve() and counts the allocations of its
+ * later generations, including the statistics and the termination checks.
+ * \param threads is the number of reproduction threads.
+ * \return the number of allocations made by the counted generations.
+ */
+long CountEvolveAllocations(unsigned int threads)
+{
+	Random rng(1);
+	CityTable table(200, rng);
+	SteadyStateGA *ga = CreateGA(table, threads);
+	ga->setVerbose(false);
+
+	// every rule is on so each of them is checked every generation, none of them is met early
+	Termination & termination = ga->getTermination();
+	termination.setMaxGenerations(55);
+	termination.setStagnationLimit(1000);
+	termination.setImprovementThreshold(-1.0, 10);
+	termination.setDiversityLimit(1e-9);
+	termination.setTargetScore(0.0);
+	termination.setTimeLimit(1e6);
+	termination.setMaxEvaluations(1ULL << 40);
+
+	AllocationObserver observer(5);
+	ga->addObserver(&observer);
+	ga->evolve();
+	long count = observer.getCount();
+
+	delete ga;
+	return count;
+}
+
+int main()
+{
+	int failures = 0;
+	unsigned int threads[] = { 1, 4 };
+
+	for(unsigned int i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i)
+	{
+		long count = CountAllocations(threads[i]);
+		cout << threads[i] << " thread(s): " << count << " allocations in 50 generations" << endl;
+		if(count != 0)
+			++failures;
+
+		count = CountEvolveAllocations(threads[i]);
+		cout << threads[i] << " thread(s): " << count << " allocations in 50 generations of evolve()" << endl;
+		if(count != 0)
+			++failures;
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/**
+ * \file EvaluationThreadsCheck.cpp
+ * Checks that a population evaluated on 8 threads gets exactly the scores it gets on 1,
+ * and that a copy of a population evaluates on as many threads as the original.
+ * It returns 0 if both hold. Built with -fsanitize=thread it also checks for data races.
+ */
+
+#include <iostream>
+
+#include "CityTable.h"
+#include "TSPIndexGenome.h"
+#include "Population.h"
+#include "Random.h"
+
+using namespace std;
+
+/**
+ * Makes a population of random tours that have not been evaluated.
+ * \param table is the cities of the tours.
+ * \param threads is the number of threads to evaluate on.
+ * \return a pointer to the population.
+ */
+Population * CreatePopulation(CityTable & table, unsigned int threads)
+{
+	Random rng(1);
+	TSPIndexGenome genome(&table);
+	genome.initialize(rng);
+
+	Population *pop = new Population();
+	pop->setEvaluationThreads(threads);
+	for(int i = 0; i < 1000; ++i)
+		pop->addGenome(genome.premuteClone(rng));
+	return pop;
+}
+
+int main()
+{
+	int failures = 0;
+	Random rng(2);
+	CityTable table(200, rng);
+
+	Population *serial = CreatePopulation(table, 1);
+	Population *parallel = CreatePopulation(table, 8);
+	serial->evaluatePopulationScores();
+	parallel->evaluatePopulationScores();
+
+	if(serial->getEvaluationCount() != parallel->getEvaluationCount())
+	{
+		cout << "the populations evaluated different numbers of genomes" << endl;
+		++failures;
+	}
+	for(int i = 0; i < serial->getPopSize(); ++i)
+	{
+		if(serial->getScore(i) != parallel->getScore(i))
+		{
+			cout << "genome " << i << " scored " << serial->getScore(i) << " on 1 thread and "
+				<< parallel->getScore(i) << " on 8" << endl;
+			++failures;
+		}
+	}
+
+	Population copy(*parallel);
+	if(copy.getEvaluationThreads() != parallel->getEvaluationThreads())
+	{
+		cout << "the copy evaluates on " << copy.getEvaluationThreads() << " threads, not "
+			<< parallel->getEvaluationThreads() << endl;
+		++failures;
+	}
+
+	delete serial;
+	delete parallel;
+
+	cout << (failures == 0 ? "passed" : "failed") << endl;
+	return failures == 0 ? 0 : 1;
+}